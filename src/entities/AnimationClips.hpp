@@ -0,0 +1,62 @@
+#ifndef ANIMATIONCLIPS_HPP
+#define ANIMATIONCLIPS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Every sprite animation as a constant frame table. An object's entity store
+// row holds only a clip id and a frame index, so starting an animation never
+// allocates.
+enum class AnimationClip : uint8_t {
+    NONE,
+    MURPHY_WALK_LEFT,
+    MURPHY_WALK_RIGHT,
+    ZONK_ROLL_RIGHT,
+    ZONK_ROLL_LEFT,
+    INFOTRON_COLLECT,
+    BASE_DIG,
+    COUNT
+};
+
+struct AnimationClipData {
+    const int* frames;  // Sprite ids
+    int frameCount;
+    float frameDuration;  // Seconds per frame
+};
+
+namespace AnimationClips {
+
+constexpr int MURPHY_WALK_LEFT_FRAMES[] = {8, 9, 10, 9, 8};
+constexpr int MURPHY_WALK_RIGHT_FRAMES[] = {11, 12, 13, 12, 11};
+constexpr int ZONK_ROLL_RIGHT_FRAMES[] = {97, 98, 99};
+constexpr int ZONK_ROLL_LEFT_FRAMES[] = {99, 98, 97};
+constexpr int INFOTRON_COLLECT_FRAMES[] = {121, 122, 123, 124, 125, 126, 127};
+constexpr int BASE_DIG_FRAMES[] = {40, 41, 42, 43, 44};
+
+template<size_t N>
+constexpr AnimationClipData clip(const int (&frames)[N], float frameDuration) {
+    return {frames, static_cast<int>(N), frameDuration};
+}
+
+// Indexed by AnimationClip
+constexpr AnimationClipData TABLE[] = {
+    {nullptr, 0, 0.0f},
+    clip(MURPHY_WALK_LEFT_FRAMES, 0.15f),
+    clip(MURPHY_WALK_RIGHT_FRAMES, 0.15f),
+    clip(ZONK_ROLL_RIGHT_FRAMES, 0.1f),
+    clip(ZONK_ROLL_LEFT_FRAMES, 0.1f),
+    clip(INFOTRON_COLLECT_FRAMES, 0.04f),
+    clip(BASE_DIG_FRAMES, 0.04f),
+};
+static_assert(sizeof(TABLE) / sizeof(TABLE[0]) == static_cast<size_t>(AnimationClip::COUNT),
+              "One table entry per AnimationClip");
+
+constexpr const AnimationClipData& get(AnimationClip id) { return TABLE[static_cast<size_t>(id)]; }
+constexpr int frame(AnimationClip id, int index) { return get(id).frames[index]; }
+
+// For snapshot loading: anything else is a corrupt id
+constexpr bool isValid(AnimationClip id) { return id < AnimationClip::COUNT; }
+
+}
+
+#endif // ANIMATIONCLIPS_HPP
@@ -1,41 +1,47 @@
 #include "BaseObject.hpp"
 
-const std::vector<int> BaseObject::DIGGING_SPRITES = {40, 41, 42, 43, 44};
-
-BaseObject::BaseObject(int x, int y) 
-    : GameObject(x, y, ObjectType::BASE), digging(false), animationTimer(0.0f), 
-      frameDuration(0.04f), currentFrame(0), animating(false) {  // Change this value to adjust speed
+BaseObject::BaseObject(EntityStore& store, int x, int y)
+    : GameObject(store, x, y, ObjectType::BASE), digging(false) {
     setSpriteId(SPRITE_BASE);
 }
 
 void BaseObject::update(float deltaTime) {
-    if (animating) {
-        animationTimer += deltaTime;
-        
-        if (animationTimer >= frameDuration) {
-            animationTimer = 0.0f;
-            currentFrame++;
+    if (isAnimating()) {
+        if (advanceClip(deltaTime)) {
+            const AnimationClipData& clip = AnimationClips::get(DIG_CLIP);
+            int frame = getClipFrame() + 1;
+            setClipFrame(frame);
             
-            if (currentFrame >= static_cast<int>(DIGGING_SPRITES.size())) {
+            if (frame >= clip.frameCount) {
                 // Animation complete - BASE is now fully removed
-                animating = false;
+                stopClip();
+                setBusy(false);
                 setActive(false);
                 
                 // Trigger immediate gravity check for zonks above this position
                 // This will be handled by the level's cleanup system
             } else {
-                setSpriteId(DIGGING_SPRITES[currentFrame]);
+                setSpriteId(clip.frames[frame]);
             }
         }
     }
 }
 
+void BaseObject::saveState(StateWriter& out) const {
+    GameObject::saveState(out);
+    out.write(digging);
+}
+
+bool BaseObject::loadState(StateReader& in, Level* level) {
+    bool valid = GameObject::loadState(in, level);
+    in.read(digging);
+    return valid && in.ok();
+}
+
 void BaseObject::startDigging() {
     if (digging) return;
     
     digging = true;
-    animating = true;
-    currentFrame = 0;
-    animationTimer = 0.0f;
-    setSpriteId(DIGGING_SPRITES[0]);
+    startClip(DIG_CLIP);
+    setBusy(true);
 }
@@ -2,26 +2,25 @@
 #define BASEOBJECT_HPP
 
 #include "GameObject.hpp"
-#include <vector>
+#include "AnimationClips.hpp"
 
 class BaseObject : public GameObject {
 public:
-    BaseObject(int x, int y);
+    BaseObject(EntityStore& store, int x, int y);
     
     void update(float deltaTime) override;
     
     void startDigging();
     bool isDigging() const { return digging; }
     
+    void saveState(StateWriter& out) const override;
+    bool loadState(StateReader& in, Level* level) override;
+    
 private:
     bool digging;
-    float animationTimer;
-    float frameDuration;
-    int currentFrame;
-    bool animating;
     
     static const int SPRITE_BASE = 2;
-    static const std::vector<int> DIGGING_SPRITES;
+    static constexpr AnimationClip DIG_CLIP = AnimationClip::BASE_DIG;
 };
 
 #endif // BASEOBJECT_HPP
@@ -1,7 +1,7 @@
 #include "ChipObject.hpp"
 
-ChipObject::ChipObject(int x, int y) 
-    : GameObject(x, y, ObjectType::CHIP_1), collected(false) {
+ChipObject::ChipObject(EntityStore& store, int x, int y) 
+    : GameObject(store, x, y, ObjectType::CHIP_1), collected(false) {
     setSpriteId(SPRITE_CHIP);
 }
 
@@ -10,6 +10,17 @@ void ChipObject::update(float deltaTime) {
     // In original game, chips might have special behavior
 }
 
+void ChipObject::saveState(StateWriter& out) const {
+    GameObject::saveState(out);
+    out.write(collected);
+}
+
+bool ChipObject::loadState(StateReader& in, Level* level) {
+    bool valid = GameObject::loadState(in, level);
+    in.read(collected);
+    return valid && in.ok();
+}
+
 void ChipObject::collect() {
     collected = true;
     setActive(false);
@@ -5,7 +5,7 @@
 
 class ChipObject : public GameObject {
 public:
-    ChipObject(int x, int y);
+    ChipObject(EntityStore& store, int x, int y);
     
     void update(float deltaTime) override;
     
@@ -13,6 +13,9 @@ public:
     void collect();
     bool isCollected() const { return collected; }
     
+    void saveState(StateWriter& out) const override;
+    bool loadState(StateReader& in, Level* level) override;
+    
 private:
     bool collected;
     
@@ -0,0 +1,88 @@
+#include "EntityStore.hpp"
+#include "GameObject.hpp"
+
+EntityStore::Slot EntityStore::add(GameObject* object, ObjectType type, int x, int y) {
+    Slot slot = static_cast<Slot>(objects.size());
+    
+    objects.push_back(object);
+    types.push_back(type);
+    xs.push_back(static_cast<int16_t>(x));
+    ys.push_back(static_cast<int16_t>(y));
+    flags.push_back(ACTIVE);
+    spriteIds.push_back(0);
+    renderXs.push_back(static_cast<float>(x));
+    renderYs.push_back(static_cast<float>(y));
+    prevRenderXs.push_back(static_cast<float>(x));
+    prevRenderYs.push_back(static_cast<float>(y));
+    clips.push_back(AnimationClip::NONE);
+    frames.push_back(0);
+    frameTimes.push_back(0.0f);
+    return slot;
+}
+
+EntityStore::Slot EntityStore::remove(Slot slot) {
+    Slot last = static_cast<Slot>(objects.size() - 1);
+    if (slot != last) {
+        objects[slot] = objects[last];
+        types[slot] = types[last];
+        xs[slot] = xs[last];
+        ys[slot] = ys[last];
+        flags[slot] = flags[last];
+        spriteIds[slot] = spriteIds[last];
+        renderXs[slot] = renderXs[last];
+        renderYs[slot] = renderYs[last];
+        prevRenderXs[slot] = prevRenderXs[last];
+        prevRenderYs[slot] = prevRenderYs[last];
+        clips[slot] = clips[last];
+        frames[slot] = frames[last];
+        frameTimes[slot] = frameTimes[last];
+        objects[slot]->slot = slot;
+    }
+    
+    objects.pop_back();
+    types.pop_back();
+    xs.pop_back();
+    ys.pop_back();
+    flags.pop_back();
+    spriteIds.pop_back();
+    renderXs.pop_back();
+    renderYs.pop_back();
+    prevRenderXs.pop_back();
+    prevRenderYs.pop_back();
+    clips.pop_back();
+    frames.pop_back();
+    frameTimes.pop_back();
+    return slot != last ? last : NO_SLOT;
+}
+
+void EntityStore::clear() {
+    objects.clear();
+    types.clear();
+    xs.clear();
+    ys.clear();
+    flags.clear();
+    spriteIds.clear();
+    renderXs.clear();
+    renderYs.clear();
+    prevRenderXs.clear();
+    prevRenderYs.clear();
+    clips.clear();
+    frames.clear();
+    frameTimes.clear();
+}
+
+void EntityStore::reserve(size_t count) {
+    objects.reserve(count);
+    types.reserve(count);
+    xs.reserve(count);
+    ys.reserve(count);
+    flags.reserve(count);
+    spriteIds.reserve(count);
+    renderXs.reserve(count);
+    renderYs.reserve(count);
+    prevRenderXs.reserve(count);
+    prevRenderYs.reserve(count);
+    clips.reserve(count);
+    frames.reserve(count);
+    frameTimes.reserve(count);
+}
@@ -0,0 +1,87 @@
+#ifndef ENTITYSTORE_HPP
+#define ENTITYSTORE_HPP
+
+#include "../main.hpp"
+#include "AnimationClips.hpp"
+#include <vector>
+
+class GameObject;
+enum class ObjectType;
+
+// Per-object state shared by every object type, kept as parallel arrays
+// indexed by slot. A slot is the object's index in the live list: removing an
+// object moves the last one into its place, so the arrays stay dense and the
+// level's loops over them never skip holes. GameObject subclasses keep only
+// their own behaviour state and read everything else from here.
+class EntityStore {
+public:
+    using Slot = uint16_t;
+    static constexpr Slot NO_SLOT = UINT16_MAX;
+    static constexpr size_t MAX_OBJECTS = NO_SLOT;
+    
+    enum Flag : uint8_t {
+        ACTIVE = 1 << 0,
+        AWAKE = 1 << 1,      // In the level's active set
+        BUSY = 1 << 2,       // Not idle: has to be updated every tick
+        ANIMATING = 1 << 3,  // Stepping through its animation clip
+    };
+    
+    EntityStore() = default;
+    EntityStore(const EntityStore&) = delete;
+    EntityStore& operator=(const EntityStore&) = delete;
+    
+    // Appends a row for a new object and returns its slot
+    Slot add(GameObject* object, ObjectType type, int x, int y);
+    // Moves the last row into `slot` and drops the last row. Returns the slot
+    // the moved object came from, or NO_SLOT when `slot` was the last one.
+    Slot remove(Slot slot);
+    void clear();
+    void reserve(size_t count);
+    
+    size_t size() const { return objects.size(); }
+    const std::vector<GameObject*>& getObjects() const { return objects; }
+    GameObject* getObject(Slot slot) const { return objects[slot]; }
+    
+    ObjectType getType(Slot slot) const { return types[slot]; }
+    int getX(Slot slot) const { return xs[slot]; }
+    int getY(Slot slot) const { return ys[slot]; }
+    void setPosition(Slot slot, int x, int y) {
+        xs[slot] = static_cast<int16_t>(x);
+        ys[slot] = static_cast<int16_t>(y);
+    }
+    
+    bool hasFlag(Slot slot, Flag flag) const { return (flags[slot] & flag) != 0; }
+    void setFlag(Slot slot, Flag flag, bool state) {
+        flags[slot] = state ? (flags[slot] | flag) : (flags[slot] & ~flag);
+    }
+    uint8_t getFlags(Slot slot) const { return flags[slot]; }
+    
+    int getSpriteId(Slot slot) const { return spriteIds[slot]; }
+    void setSpriteId(Slot slot, int spriteId) { spriteIds[slot] = static_cast<int16_t>(spriteId); }
+    
+    // Where the renderer draws the object, in cells: the position after the
+    // last tick and the one before it, interpolated by alpha
+    float getRenderX(Slot slot, float alpha) const { return prevRenderXs[slot] + (renderXs[slot] - prevRenderXs[slot]) * alpha; }
+    float getRenderY(Slot slot, float alpha) const { return prevRenderYs[slot] + (renderYs[slot] - prevRenderYs[slot]) * alpha; }
+    
+    // Animation: clip id, frame index into the clip and time spent on the frame
+    AnimationClip getClip(Slot slot) const { return clips[slot]; }
+    int getFrame(Slot slot) const { return frames[slot]; }
+    float getFrameTime(Slot slot) const { return frameTimes[slot]; }
+    
+private:
+    friend class GameObject;
+    
+    std::vector<GameObject*> objects;  // Behaviour, for update() and type-specific state
+    std::vector<ObjectType> types;
+    std::vector<int16_t> xs, ys;
+    std::vector<uint8_t> flags;
+    std::vector<int16_t> spriteIds;
+    std::vector<float> renderXs, renderYs;
+    std::vector<float> prevRenderXs, prevRenderYs;
+    std::vector<AnimationClip> clips;
+    std::vector<uint8_t> frames;
+    std::vector<float> frameTimes;
+};
+
+#endif // ENTITYSTORE_HPP
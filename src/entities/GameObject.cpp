@@ -1,22 +1,64 @@
 #include "GameObject.hpp"
-#include "../systems/AssetManager.hpp"
 
-GameObject::GameObject(int x, int y, ObjectType type) 
-    : x(x), y(y), type(type), active(true) {
-    
-    SDL_Texture* spriteTexture = AssetManager::getInstance().getTexture("sprites");
-    sprite = Sprite(spriteTexture, 0); // Default sprite
+GameObject::GameObject(EntityStore& store, int x, int y, ObjectType type)
+    : store(&store), slot(store.add(this, type, x, y)) {
 }
 
-void GameObject::render(SDL_Renderer* renderer, float offsetX, float offsetY) {
-    if (!active) return;
-    
-    // Ensure pixel-perfect positioning by rounding to nearest pixel
-    int renderX = static_cast<int>(roundf((x * TILE_SIZE) + offsetX));
-    int renderY = static_cast<int>(roundf((y * TILE_SIZE) + offsetY));
-    sprite.render(renderer, renderX, renderY);
+void GameObject::setRenderPosition(float renderX, float renderY) {
+    store->renderXs[slot] = renderX;
+    store->renderYs[slot] = renderY;
+}
+
+void GameObject::beginRenderTick() {
+    store->prevRenderXs[slot] = store->renderXs[slot];
+    store->prevRenderYs[slot] = store->renderYs[slot];
+}
+
+void GameObject::startClip(AnimationClip clip) {
+    store->clips[slot] = clip;
+    store->frames[slot] = 0;
+    store->frameTimes[slot] = 0.0f;
+    store->setFlag(slot, EntityStore::ANIMATING, true);
+    setSpriteId(AnimationClips::frame(clip, 0));
 }
 
-void GameObject::setSpriteId(int spriteId) {
-    sprite.setSpriteId(spriteId);
+bool GameObject::advanceClip(float deltaTime) {
+    float& frameTime = store->frameTimes[slot];
+    frameTime += deltaTime;
+    if (frameTime < AnimationClips::get(store->clips[slot]).frameDuration) {
+        return false;
+    }
+    frameTime = 0.0f;
+    return true;
+}
+
+void GameObject::saveState(StateWriter& out) const {
+    // Everything in the store row except position and type, which Level
+    // writes, and the awake flag, which follows from Level's awake list
+    out.write(static_cast<uint8_t>(store->flags[slot] & ~EntityStore::AWAKE));
+    out.write(store->spriteIds[slot]);
+    out.write(store->renderXs[slot]);
+    out.write(store->renderYs[slot]);
+    out.write(store->prevRenderXs[slot]);
+    out.write(store->prevRenderYs[slot]);
+    out.write(store->clips[slot]);
+    out.write(store->frames[slot]);
+    out.write(store->frameTimes[slot]);
+}
+
+bool GameObject::loadState(StateReader& in, Level* level) {
+    uint8_t flags = 0;
+    in.read(flags);
+    in.read(store->spriteIds[slot]);
+    in.read(store->renderXs[slot]);
+    in.read(store->renderYs[slot]);
+    in.read(store->prevRenderXs[slot]);
+    in.read(store->prevRenderYs[slot]);
+    in.read(store->clips[slot]);
+    in.read(store->frames[slot]);
+    in.read(store->frameTimes[slot]);
+    store->flags[slot] = (flags & ~EntityStore::AWAKE) | (store->flags[slot] & EntityStore::AWAKE);
+    
+    AnimationClip clip = store->clips[slot];
+    return in.ok() && AnimationClips::isValid(clip) && store->frames[slot] <= AnimationClips::get(clip).frameCount;
 }
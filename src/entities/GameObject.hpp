@@ -2,9 +2,12 @@
 #define GAMEOBJECT_HPP
 
 #include "../main.hpp"
-#include "../systems/Sprite.hpp"
+#include "../systems/StateStream.hpp"
+#include "EntityStore.hpp"
 #include <vector>
 
+class Level;
+
 enum class ObjectType {
     PLAYER,
     BASE,
@@ -17,7 +20,7 @@ enum class ObjectType {
     
     // Add missing types referenced in LevelLoader
     CHIP_1,
-    CHIP_2, 
+    CHIP_2,
     CHIP_3,
     
     HARDWARE_1,
@@ -42,34 +45,67 @@ enum class ObjectType {
 
 class GameObject {
 public:
-    GameObject(int x, int y, ObjectType type);
+    GameObject(EntityStore& store, int x, int y, ObjectType type);
     virtual ~GameObject() = default;
     
     virtual void update(float deltaTime) {}
-    virtual void render(SDL_Renderer* renderer, float offsetX, float offsetY);
+    
+    // Where this object's shared state lives in the level's entity store
+    EntityStore::Slot getSlot() const { return slot; }
     
     // Position
-    int getX() const { return x; }
-    int getY() const { return y; }
-    void setPosition(int newX, int newY) { x = newX; y = newY; }
+    int getX() const { return store->getX(slot); }
+    int getY() const { return store->getY(slot); }
+    void setPosition(int newX, int newY) { store->setPosition(slot, newX, newY); }
     
     // Type
-    ObjectType getType() const { return type; }
+    ObjectType getType() const { return store->getType(slot); }
+    int getSpriteId() const { return store->getSpriteId(slot); }
     
     // State
-    bool isActive() const { return active; }
-    void setActive(bool state) { active = state; }
+    bool isActive() const { return store->hasFlag(slot, EntityStore::ACTIVE); }
+    void setActive(bool state) { store->setFlag(slot, EntityStore::ACTIVE, state); }
+    
+    // Scheduling: idle objects are left out of Level's update list until woken
+    bool isIdle() const { return !store->hasFlag(slot, EntityStore::BUSY); }
+    bool isAwake() const { return store->hasFlag(slot, EntityStore::AWAKE); }
+    void setAwake(bool state) { store->setFlag(slot, EntityStore::AWAKE, state); }
+    
+    // Render position in cells. Moving objects copy it to the previous one at
+    // the start of each tick, so the renderer can interpolate between ticks.
+    float getRenderX() const { return store->renderXs[slot]; }
+    float getRenderY() const { return store->renderYs[slot]; }
+    
+    // Snapshots: position and type are stored by Level, the rest by each object.
+    // Subclasses call the base version first.
+    virtual void saveState(StateWriter& out) const;
+    virtual bool loadState(StateReader& in, Level* level);
     
 protected:
-    void setSpriteId(int spriteId);
+    void setSpriteId(int spriteId) { store->setSpriteId(slot, spriteId); }
+    void setBusy(bool state) { store->setFlag(slot, EntityStore::BUSY, state); }
+    
+    float getPrevRenderX() const { return store->prevRenderXs[slot]; }
+    float getPrevRenderY() const { return store->prevRenderYs[slot]; }
+    void setRenderPosition(float renderX, float renderY);
+    void beginRenderTick();
     
-    int x, y;
-    ObjectType type;
-    bool active;
+    // Animation clip playback. advanceClip adds deltaTime to the current frame
+    // and returns true once the frame's duration is used up; the caller then
+    // picks the next frame with setClipFrame.
+    AnimationClip getClip() const { return store->clips[slot]; }
+    int getClipFrame() const { return store->frames[slot]; }
+    bool isAnimating() const { return store->hasFlag(slot, EntityStore::ANIMATING); }
+    void startClip(AnimationClip clip);
+    void stopClip() { store->setFlag(slot, EntityStore::ANIMATING, false); }
+    bool advanceClip(float deltaTime);
+    void setClipFrame(int frame) { store->frames[slot] = static_cast<uint8_t>(frame); }
     
-    Sprite sprite;
+private:
+    friend class EntityStore;
     
-    static const int TILE_SIZE = 16;
+    EntityStore* store;
+    EntityStore::Slot slot;
 };
 
 #endif // GAMEOBJECT_HPP
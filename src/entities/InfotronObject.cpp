@@ -1,39 +1,47 @@
 #include "InfotronObject.hpp"
 
-const std::vector<int> InfotronObject::COLLECTING_SPRITES = {121, 122, 123, 124, 125, 126, 127};
-
-InfotronObject::InfotronObject(int x, int y) 
-    : GameObject(x, y, ObjectType::INFOTRON), collected(false), collecting(false),
-      animationTimer(0.0f), frameDuration(0.04f), currentFrame(0), animating(false) {
+InfotronObject::InfotronObject(EntityStore& store, int x, int y)
+    : GameObject(store, x, y, ObjectType::INFOTRON), collected(false), collecting(false) {
     setSpriteId(SPRITE_INFOTRON);
 }
 
 void InfotronObject::update(float deltaTime) {
-    if (animating) {
-        animationTimer += deltaTime;
-        
-        if (animationTimer >= frameDuration) {
-            animationTimer = 0.0f;
-            currentFrame++;
+    if (isAnimating()) {
+        if (advanceClip(deltaTime)) {
+            const AnimationClipData& clip = AnimationClips::get(COLLECT_CLIP);
+            int frame = getClipFrame() + 1;
+            setClipFrame(frame);
             
-            if (currentFrame >= static_cast<int>(COLLECTING_SPRITES.size())) {
+            if (frame >= clip.frameCount) {
                 // Animation complete
-                animating = false;
+                stopClip();
+                setBusy(false);
                 collected = true;
                 setActive(false);
             } else {
-                setSpriteId(COLLECTING_SPRITES[currentFrame]);
+                setSpriteId(clip.frames[frame]);
             }
         }
     }
 }
 
+void InfotronObject::saveState(StateWriter& out) const {
+    GameObject::saveState(out);
+    out.write(collected);
+    out.write(collecting);
+}
+
+bool InfotronObject::loadState(StateReader& in, Level* level) {
+    bool valid = GameObject::loadState(in, level);
+    in.read(collected);
+    in.read(collecting);
+    return valid && in.ok();
+}
+
 void InfotronObject::collect() {
     if (collected || collecting) return;
     
     collecting = true;
-    animating = true;
-    currentFrame = 0;
-    animationTimer = 0.0f;
-    setSpriteId(COLLECTING_SPRITES[0]);
+    startClip(COLLECT_CLIP);
+    setBusy(true);
 }
@@ -2,11 +2,11 @@
 #define INFOTRONOBJECT_HPP
 
 #include "GameObject.hpp"
-#include <vector>
+#include "AnimationClips.hpp"
 
 class InfotronObject : public GameObject {
 public:
-    InfotronObject(int x, int y);
+    InfotronObject(EntityStore& store, int x, int y);
     
     void update(float deltaTime) override;
     
@@ -14,16 +14,15 @@ public:
     bool isCollected() const { return collected; }
     bool isCollecting() const { return collecting; }  // Add collecting state check
     
+    void saveState(StateWriter& out) const override;
+    bool loadState(StateReader& in, Level* level) override;
+    
 private:
     bool collected;
     bool collecting;  // Track if currently playing collection animation
-    float animationTimer;
-    float frameDuration;
-    int currentFrame;
-    bool animating;
     
     static const int SPRITE_INFOTRON = 4;
-    static const std::vector<int> COLLECTING_SPRITES;  // Animation sprites 121-127
+    static constexpr AnimationClip COLLECT_CLIP = AnimationClip::INFOTRON_COLLECT;
 };
 
 #endif // INFOTRONOBJECT_HPP
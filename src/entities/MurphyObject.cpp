@@ -1,32 +1,67 @@
 #include "MurphyObject.hpp"
 #include "../game/Level.hpp"
-#include "../systems/AssetManager.hpp"
 #include <iostream>
 
-MurphyObject::MurphyObject(int startX, int startY) 
-    : GameObject(startX, startY, ObjectType::PLAYER),
-      renderX(startX), renderY(startY), targetX(startX), targetY(startY),
-      moving(false), moveSpeed(MOVE_SPEED), currentFrame(0), animationTimer(0.0f),
-      frameDuration(ANIMATION_SPEED), isAnimating(false), idleSprite(MURPHY_IDLE),
+MurphyObject::MurphyObject(EntityStore& store, int startX, int startY)
+    : GameObject(store, startX, startY, ObjectType::PLAYER),
+      targetX(startX), targetY(startY),
+      moving(false), moveSpeed(MOVE_SPEED), idleSprite(MURPHY_IDLE),
       pendingMoveX(0), pendingMoveY(0), facingDirection(FacingDirection::IDLE),
-      isDigging(false), hasPendingObjectRemoval(false), pendingRemovalX(0), 
+      isDigging(false), hasPendingObjectRemoval(false), pendingRemovalX(0),
       pendingRemovalY(0), pendingLevel(nullptr), previousX(startX), previousY(startY) {
     
     setSpriteId(MURPHY_IDLE);
+    setBusy(true);  // Polls input every tick, so never idle
 }
 
 void MurphyObject::update(float deltaTime) {
+    beginRenderTick();
+    
     updateAnimation(deltaTime);
     updateMovement(deltaTime);
 }
 
-void MurphyObject::render(SDL_Renderer* renderer, float offsetX, float offsetY) {
-    if (!active) return;
-    
-    // Use smooth renderX/Y for movement, but ensure pixel-perfect positioning
-    int pixelX = static_cast<int>(roundf((renderX * TILE_SIZE) + offsetX));
-    int pixelY = static_cast<int>(roundf((renderY * TILE_SIZE) + offsetY));
-    sprite.render(renderer, pixelX, pixelY);
+void MurphyObject::saveState(StateWriter& out) const {
+    GameObject::saveState(out);
+    out.write(targetX);
+    out.write(targetY);
+    out.write(moving);
+    out.write(moveSpeed);
+    out.write(idleSprite);
+    out.write(pendingMoveX);
+    out.write(pendingMoveY);
+    out.write(currentInput);
+    out.write(facingDirection);
+    out.write(isDigging);
+    out.write(hasPendingObjectRemoval);
+    out.write(pendingRemovalX);
+    out.write(pendingRemovalY);
+    out.write(pendingLevel != nullptr);
+    out.write(previousX);
+    out.write(previousY);
+}
+
+bool MurphyObject::loadState(StateReader& in, Level* level) {
+    bool valid = GameObject::loadState(in, level);
+    bool hasPendingLevel = false;
+    in.read(targetX);
+    in.read(targetY);
+    in.read(moving);
+    in.read(moveSpeed);
+    in.read(idleSprite);
+    in.read(pendingMoveX);
+    in.read(pendingMoveY);
+    in.read(currentInput);
+    in.read(facingDirection);
+    in.read(isDigging);
+    in.read(hasPendingObjectRemoval);
+    in.read(pendingRemovalX);
+    in.read(pendingRemovalY);
+    in.read(hasPendingLevel);
+    in.read(previousX);
+    in.read(previousY);
+    pendingLevel = hasPendingLevel ? level : nullptr;
+    return valid && in.ok();
 }
 
 void MurphyObject::handleInput(const SDL_Event& event, Level* level) {
@@ -38,27 +73,27 @@ void MurphyObject::processInput(Level* level) {
 }
 
 void MurphyObject::checkContinuousInput(Level* level) {
-    const Uint8* keystate = SDL_GetKeyboardState(NULL);
+    currentInput = level->pollInput();
     
-    bool spacePressed = keystate[SDL_SCANCODE_SPACE];
+    bool spacePressed = currentInput.isPressed(InputState::DIG);
     
     pendingMoveX = 0;
     pendingMoveY = 0;
     
-    if (keystate[SDL_SCANCODE_LEFT] || keystate[SDL_SCANCODE_A]) {
+    if (currentInput.isPressed(InputState::LEFT)) {
         pendingMoveX = -1;
         facingDirection = FacingDirection::LEFT;
         idleSprite = MURPHY_LEFT_1;
     }
-    else if (keystate[SDL_SCANCODE_RIGHT] || keystate[SDL_SCANCODE_D]) {
+    else if (currentInput.isPressed(InputState::RIGHT)) {
         pendingMoveX = 1;
         facingDirection = FacingDirection::RIGHT;
         idleSprite = MURPHY_RIGHT_1;
     }
-    else if (keystate[SDL_SCANCODE_UP] || keystate[SDL_SCANCODE_W]) {
+    else if (currentInput.isPressed(InputState::UP)) {
         pendingMoveY = -1;
     }
-    else if (keystate[SDL_SCANCODE_DOWN] || keystate[SDL_SCANCODE_S]) {
+    else if (currentInput.isPressed(InputState::DOWN)) {
         pendingMoveY = 1;
     }
     
@@ -72,8 +107,8 @@ void MurphyObject::checkContinuousInput(Level* level) {
 }
 
 void MurphyObject::dig(int dx, int dy, Level* level) {
-    int targetX = x + dx;
-    int targetY = y + dy;
+    int targetX = getX() + dx;
+    int targetY = getY() + dy;
     
     if (targetX < 0 || targetX >= Level::LEVEL_WIDTH || targetY < 0 || targetY >= Level::LEVEL_HEIGHT) {
         return;
@@ -98,8 +133,8 @@ void MurphyObject::dig(int dx, int dy, Level* level) {
 }
 
 void MurphyObject::move(int dx, int dy, Level* level) {
-    int newX = x + dx;
-    int newY = y + dy;
+    int newX = getX() + dx;
+    int newY = getY() + dy;
     
     if (level->isWalkable(newX, newY)) {
         GameObject* obj = level->getObjectAt(newX, newY);
@@ -117,11 +152,10 @@ void MurphyObject::move(int dx, int dy, Level* level) {
         }
         
         // Store previous position before moving
-        previousX = x;
-        previousY = y;
+        previousX = getX();
+        previousY = getY();
         
-        x = newX;
-        y = newY;
+        level->moveObject(this, newX, newY);
         
         targetX = static_cast<float>(newX);
         targetY = static_cast<float>(newY);
@@ -129,14 +163,14 @@ void MurphyObject::move(int dx, int dy, Level* level) {
         pendingLevel = level;  // Store level reference for gravity callback
         
         if (dx == -1) {
-            startAnimation({MURPHY_LEFT_1, MURPHY_LEFT_2, MURPHY_LEFT_3, MURPHY_LEFT_2, MURPHY_LEFT_1}, ANIMATION_SPEED);
+            startClip(AnimationClip::MURPHY_WALK_LEFT);
         } else if (dx == 1) {
-            startAnimation({MURPHY_RIGHT_1, MURPHY_RIGHT_2, MURPHY_RIGHT_3, MURPHY_RIGHT_2, MURPHY_RIGHT_1}, ANIMATION_SPEED);
+            startClip(AnimationClip::MURPHY_WALK_RIGHT);
         } else if (dy == -1 || dy == 1) {
             if (facingDirection == FacingDirection::LEFT) {
-                startAnimation({MURPHY_LEFT_1, MURPHY_LEFT_2, MURPHY_LEFT_3, MURPHY_LEFT_2, MURPHY_LEFT_1}, ANIMATION_SPEED);
+                startClip(AnimationClip::MURPHY_WALK_LEFT);
             } else {
-                startAnimation({MURPHY_RIGHT_1, MURPHY_RIGHT_2, MURPHY_RIGHT_3, MURPHY_RIGHT_2, MURPHY_RIGHT_1}, ANIMATION_SPEED);
+                startClip(AnimationClip::MURPHY_WALK_RIGHT);
                 facingDirection = FacingDirection::RIGHT;
                 idleSprite = MURPHY_RIGHT_1;
             }
@@ -144,53 +178,34 @@ void MurphyObject::move(int dx, int dy, Level* level) {
     }
 }
 
-void MurphyObject::startAnimation(const std::vector<int>& frames, float frameDuration) {
-    currentAnimationFrames = frames;
-    this->frameDuration = frameDuration;
-    currentFrame = 0;
-    animationTimer = 0.0f;
-    isAnimating = true;
-    
-    if (!frames.empty()) {
-        setSpriteId(frames[0]);
-    }
-}
-
 void MurphyObject::updateAnimation(float deltaTime) {
-    if (!isAnimating || currentAnimationFrames.empty()) {
+    const AnimationClipData& clip = AnimationClips::get(getClip());
+    if (!isAnimating() || clip.frameCount == 0) {
         return;
     }
     
-    animationTimer += deltaTime;
-    
-    if (animationTimer >= frameDuration) {
-        animationTimer = 0.0f;
-        currentFrame++;
+    if (advanceClip(deltaTime)) {
+        int currentFrame = getClipFrame() + 1;
         
-        if (currentFrame >= static_cast<int>(currentAnimationFrames.size())) {
+        if (currentFrame >= clip.frameCount) {
             if (isDigging) {
                 isDigging = false;
-                isAnimating = false;
+                stopClip();
                 setSpriteId(idleSprite);
             } else {
                 currentFrame = 0;
                 
-                const Uint8* keystate = SDL_GetKeyboardState(NULL);
-                bool anyMovementKey = keystate[SDL_SCANCODE_LEFT] || keystate[SDL_SCANCODE_A] ||
-                                     keystate[SDL_SCANCODE_RIGHT] || keystate[SDL_SCANCODE_D] ||
-                                     keystate[SDL_SCANCODE_UP] || keystate[SDL_SCANCODE_W] ||
-                                     keystate[SDL_SCANCODE_DOWN] || keystate[SDL_SCANCODE_S];
-                
-                if (anyMovementKey) {
-                    setSpriteId(currentAnimationFrames[currentFrame]);
+                if (currentInput.anyDirection()) {
+                    setSpriteId(clip.frames[currentFrame]);
                 } else {
-                    isAnimating = false;
+                    stopClip();
                     setSpriteId(idleSprite);
                 }
             }
         } else {
-            setSpriteId(currentAnimationFrames[currentFrame]);
+            setSpriteId(clip.frames[currentFrame]);
         }
+        setClipFrame(currentFrame);
     }
 }
 
@@ -199,14 +214,15 @@ void MurphyObject::updateMovement(float deltaTime) {
         return;
     }
     
+    float renderX = getRenderX();
+    float renderY = getRenderY();
     float dx = targetX - renderX;
     float dy = targetY - renderY;
     float moveDistance = moveSpeed * deltaTime;
     float distanceToTarget = sqrt(dx * dx + dy * dy);
     
     if (distanceToTarget <= moveDistance) {
-        renderX = targetX;
-        renderY = targetY;
+        setRenderPosition(targetX, targetY);
         moving = false;
         
         if (hasPendingObjectRemoval && pendingLevel) {
@@ -214,16 +230,12 @@ void MurphyObject::updateMovement(float deltaTime) {
             hasPendingObjectRemoval = false;
         }
         
-        // Trigger gravity check for the tile Murphy just left (only after movement is complete)
-        if (pendingLevel) {
-            pendingLevel->triggerGravityCheckAbove(previousX, previousY);
-            pendingLevel = nullptr;  // Clear the reference
-        }
+        // The level's gravity pass picks up the tile Murphy just left
+        pendingLevel = nullptr;
     } else {
         float normalizedDx = dx / distanceToTarget;
         float normalizedDy = dy / distanceToTarget;
         
-        renderX += normalizedDx * moveDistance;
-        renderY += normalizedDy * moveDistance;
+        setRenderPosition(renderX + normalizedDx * moveDistance, renderY + normalizedDy * moveDistance);
     }
 }
@@ -2,7 +2,8 @@
 #define MURPHYOBJECT_HPP
 
 #include "GameObject.hpp"
-#include <vector>
+#include "AnimationClips.hpp"
+#include "../systems/InputProvider.hpp"
 
 class Level;
 
@@ -14,39 +15,37 @@ enum class FacingDirection {
 
 class MurphyObject : public GameObject {
 public:
-    MurphyObject(int startX, int startY);
+    MurphyObject(EntityStore& store, int startX, int startY);
     
     void update(float deltaTime) override;
-    void render(SDL_Renderer* renderer, float offsetX, float offsetY) override;
     
     void handleInput(const SDL_Event& event, Level* level);
     void processInput(Level* level);
     
-    float getRenderX() const { return renderX; }
-    float getRenderY() const { return renderY; }
     bool isMoving() const { return moving; }
+    // Not moving, not animating, and the last tick's interpolation has finished
+    bool isStill() const {
+        return !moving && !isAnimating() && getRenderX() == getPrevRenderX() && getRenderY() == getPrevRenderY();
+    }
+    
+    void saveState(StateWriter& out) const override;
+    bool loadState(StateReader& in, Level* level) override;
     
 private:
     void move(int dx, int dy, Level* level);
     void dig(int dx, int dy, Level* level);
-    void startAnimation(const std::vector<int>& frames, float frameDuration);
     void updateAnimation(float deltaTime);
     void updateMovement(float deltaTime);
     void checkContinuousInput(Level* level);
     
-    float renderX, renderY;
     float targetX, targetY;
     bool moving;
     float moveSpeed;
     
-    std::vector<int> currentAnimationFrames;
-    int currentFrame;
-    float animationTimer;
-    float frameDuration;
-    bool isAnimating;
     int idleSprite;
     
     int pendingMoveX, pendingMoveY;
+    InputState currentInput;  // Buttons held this tick, from the level's InputProvider
     FacingDirection facingDirection;
     bool isDigging;
     
@@ -59,11 +58,7 @@ private:
     
     static const int MURPHY_IDLE = 3;
     static const int MURPHY_LEFT_1 = 8;
-    static const int MURPHY_LEFT_2 = 9;
-    static const int MURPHY_LEFT_3 = 10;
     static const int MURPHY_RIGHT_1 = 11;
-    static const int MURPHY_RIGHT_2 = 12;
-    static const int MURPHY_RIGHT_3 = 13;
     
     // Digging sprites for each direction
     static const int MURPHY_DIG_UP = 14;
@@ -71,7 +66,6 @@ private:
     static const int MURPHY_DIG_LEFT = 25;
     static const int MURPHY_DIG_RIGHT = 24;
     
-    static constexpr float ANIMATION_SPEED = 0.15f;
     static constexpr float MOVE_SPEED = 8.0f;  // Changed from 4.0f to 8.0f to match zonk fall speed
 };
 
@@ -2,58 +2,45 @@
 #define ZONKOBJECT_HPP
 
 #include "GameObject.hpp"
-#include <vector>
+#include "AnimationClips.hpp"
 
 class Level;  // Forward declaration instead of include
 
+// Zonks don't decide anything themselves: Level's gravity pass moves them in
+// the grid and starts the fall/roll, the zonk only animates towards its cell.
 class ZonkObject : public GameObject {
 public:
-    ZonkObject(int x, int y);
+    ZonkObject(EntityStore& store, int x, int y);
     
     void update(float deltaTime) override;
-    void render(SDL_Renderer* renderer, float offsetX, float offsetY) override;
     
     bool canBePushed() const { return !falling && !rolling; }
     bool isFalling() const { return falling; }
     bool isRolling() const { return rolling; }
+    bool isMoving() const { return falling || rolling; }
+    int getRollDirection() const { return rollDirection; }
     
-    void setLevel(Level* level) { currentLevel = level; }
-    void forceGravityCheck() { fallTimer = GRAVITY_CHECK_INTERVAL; }
+    // Called by the gravity pass after it has moved the zonk into its new cell
+    void startFalling();
+    void startRolling(int direction);
+    
+    // Advance the current move; true once the zonk has arrived in its cell
+    bool advanceMotion(float deltaTime);
+    
+    void saveState(StateWriter& out) const override;
+    bool loadState(StateReader& in, Level* level) override;
     
 private:
-    void checkGravity(Level* level);
-    void updateFalling(float deltaTime);
-    void updateRolling(float deltaTime);
-    void updateRollingAnimation(float deltaTime);  // Add rolling animation
-    void tryRollOff(Level* level, int obstacleY);
-    void checkStaticRolling(Level* level);
-    bool canRollTo(Level* level, int newX, int belowY);
+    void updateRollingAnimation(float deltaTime);
     
     bool falling;
     bool rolling;
-    float fallTimer;
-    float renderY;
-    float renderX;
-    
+    float motionProgress;  // 0..1 across the current one-cell move
     int rollDirection;
-    float rollSpeed;
-    
-    // Rolling animation
-    float rollAnimationTimer;
-    int rollAnimationFrame;
-    std::vector<int> rollAnimationFrames;
-    
-    Level* currentLevel;
     
     static const int SPRITE_ZONK = 1;
     static constexpr float FALL_SPEED = 4.0f;
     static constexpr float ROLL_SPEED = 3.0f;
-    static constexpr float GRAVITY_CHECK_INTERVAL = 0.05f;
-    static constexpr float ROLL_ANIMATION_SPEED = 0.1f;  // Animation frame duration
-    
-    // Rolling animation sprites
-    static const std::vector<int> ROLL_RIGHT_SPRITES;  // 97, 98, 99
-    static const std::vector<int> ROLL_LEFT_SPRITES;   // 99, 98, 97
 };
 
 #endif // ZONKOBJECT_HPP
@@ -0,0 +1,61 @@
+#ifndef BITGRID_HPP
+#define BITGRID_HPP
+
+#include "../main.hpp"
+#include <array>
+
+// Fixed-size grid of bits with one 64-bit mask per row (bit x is column x),
+// so whole rows combine with a single bitwise op
+template<int Width, int Height>
+class BitGrid {
+public:
+    static_assert(Width > 0 && Width <= 64, "BitGrid rows are single 64-bit words");
+    static constexpr uint64_t ROW_MASK = Width == 64 ? ~uint64_t(0) : (uint64_t(1) << Width) - 1;
+    
+    BitGrid() { clear(); }
+    
+    void clear() { rows.fill(0); }
+    bool test(int x, int y) const { return (rows[y] >> x) & 1; }
+    void set(int x, int y) { rows[y] |= uint64_t(1) << x; }
+    void reset(int x, int y) { rows[y] &= ~(uint64_t(1) << x); }
+    
+    uint64_t getRow(int y) const { return rows[y]; }
+    void setRow(int y, uint64_t mask) { rows[y] = mask & ROW_MASK; }
+    
+    int count() const {
+        int total = 0;
+        for (uint64_t row : rows) {
+            total += popcount(row);
+        }
+        return total;
+    }
+    
+    bool operator==(const BitGrid& other) const { return rows == other.rows; }
+    bool operator!=(const BitGrid& other) const { return rows != other.rows; }
+    
+    // Index of the lowest set bit; bits must be non-zero
+    static int lowestBit(uint64_t bits) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(bits);
+#else
+        int index = 0;
+        for (; !(bits & 1); bits >>= 1) index++;
+        return index;
+#endif
+    }
+    
+    static int popcount(uint64_t bits) {
+#if defined(__GNUC__)
+        return __builtin_popcountll(bits);
+#else
+        int total = 0;
+        for (; bits; bits &= bits - 1) total++;
+        return total;
+#endif
+    }
+    
+private:
+    std::array<uint64_t, Height> rows;
+};
+
+#endif // BITGRID_HPP
@@ -1,15 +1,37 @@
 #include "Game.hpp"
 #include "Level.hpp"
 #include "LevelLoader.hpp"
+#include "../systems/AllocationCounter.hpp"
 #include "../systems/AssetManager.hpp"
+#include "../systems/Log.hpp"
+#include "../systems/Profiler.hpp"
+#include "../systems/StartupTrace.hpp"
 #include <chrono>
 #include <algorithm>
+#include <future>
+#include <random>
 
 const char* Game::WINDOW_TITLE = "SDL Supaplex";
+const char* Game::RECORDING_PATH = "recording.sprec";
 
 Game::Game() : window(nullptr), sdlRenderer(nullptr), currentState(GameState::MENU), 
-               isRunning(false), cameraX(0), cameraY(0), 
-               viewportWidth(0), viewportHeight(0), panelHeight(0) {
+               isRunning(false), currentLevelNumber(1), testLevelSeed(0),
+               recorder(&keyboardInput, &recording), isRecording(false),
+               rewindHistory(REWIND_SECONDS * DEFAULT_TICK_RATE), hintStart(LevelSolver::NO_CELL),
+               cameraX(0), cameraY(0), prevCameraX(0), prevCameraY(0),
+               redrawRequested(true), drawnRevision(0), drawnViewX(0), drawnViewY(0), startupReport(false),
+               tickRate(DEFAULT_TICK_RATE), tickDuration(1.0f / DEFAULT_TICK_RATE), tickAccumulator(0.0f),
+               viewportWidth(0), viewportHeight(0), panelHeight(0),
+               panelTexture(AssetManager::INVALID_TEXTURE) {
+}
+
+void Game::setTickRate(int ticksPerSecond) {
+    if (ticksPerSecond > 0) {
+        tickRate = ticksPerSecond;
+        tickDuration = 1.0f / ticksPerSecond;
+        // The history covers a fixed time, so its length follows the rate
+        rewindHistory.setCapacity(static_cast<size_t>(REWIND_SECONDS) * ticksPerSecond);
+    }
 }
 
 Game::~Game() {
@@ -17,69 +39,122 @@ Game::~Game() {
 }
 
 bool Game::initialize() {
+    StartupTrace& trace = StartupTrace::getInstance();
+    
+    // The game loop runs on this thread; asset decoding threads don't record
+    Profiler::getInstance().setRecordingThread();
+    
     // Initialize SDL
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
-        std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
-        return false;
+    {
+        StartupPhase phase("SDL init");
+        if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
+            LOG_ERROR("SDL could not initialize").field("error", SDL_GetError());
+            return false;
+        }
     }
     
-    // Create window with original resolution scaled up
-    window = SDL_CreateWindow(WINDOW_TITLE,
-                             SDL_WINDOWPOS_CENTERED,
-                             SDL_WINDOWPOS_CENTERED,
-                             WINDOW_WIDTH * SCALE_FACTOR, 
-                             WINDOW_HEIGHT * SCALE_FACTOR,
-                             SDL_WINDOW_SHOWN);
-    
-    if (!window) {
-        std::cerr << "Window could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+    // Decode images and parse the level pack on workers while the window and
+    // renderer come up; only the texture upload has to wait for the renderer
+    if (!AssetManager::getInstance().startLoading()) {
+        LOG_ERROR("Failed to initialize AssetManager");
         return false;
     }
+    std::future<bool> levelPack = std::async(std::launch::async, [this]() {
+        StartupPhase phase("Load level pack");
+        const uint8_t* packData;
+        size_t packSize;
+        if (AssetManager::getInstance().getBundleData(AssetManager::LEVEL_PACK_ENTRY, packData, packSize)) {
+            levelLoader.loadLevelsData(packData, packSize, AssetManager::BUNDLE_PATH);
+        } else if (!levelLoader.loadLevelsFile(AssetManager::getInstance().getLevelPackPath())) {
+            return false;
+        }
+        levelLoader.parseAll();
+        return true;
+    });
     
-    // Create renderer
-    sdlRenderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-    if (!sdlRenderer) {
-        std::cerr << "Renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
-        return false;
+    {
+        StartupPhase phase("Create window and renderer");
+        
+        // Create window with original resolution scaled up
+        window = SDL_CreateWindow(WINDOW_TITLE,
+                                 SDL_WINDOWPOS_CENTERED,
+                                 SDL_WINDOWPOS_CENTERED,
+                                 WINDOW_WIDTH * SCALE_FACTOR, 
+                                 WINDOW_HEIGHT * SCALE_FACTOR,
+                                 SDL_WINDOW_SHOWN);
+        
+        if (!window) {
+            LOG_ERROR("Window could not be created").field("error", SDL_GetError());
+            return false;
+        }
+        
+        // Create renderer
+        sdlRenderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+        if (!sdlRenderer) {
+            LOG_ERROR("Renderer could not be created").field("error", SDL_GetError());
+            return false;
+        }
     }
     
+    spriteBatch.setRenderer(sdlRenderer);
+    
     // Set logical size to original resolution
     SDL_RenderSetLogicalSize(sdlRenderer, WINDOW_WIDTH, WINDOW_HEIGHT);
     
     // Set renderer color
     SDL_SetRenderDrawColor(sdlRenderer, 0x00, 0x00, 0x00, 0xFF);
     
-    // Initialize AssetManager
-    if (!AssetManager::getInstance().initialize(sdlRenderer)) {
-        std::cerr << "Failed to initialize AssetManager!" << std::endl;
+    // Upload the decoded textures
+    if (!AssetManager::getInstance().finishLoading(sdlRenderer)) {
+        LOG_ERROR("Failed to initialize AssetManager");
         return false;
     }
     
     // Get panel height from loaded texture
+    panelTexture = AssetManager::getInstance().getTextureHandle("panel");
     panelHeight = AssetManager::getInstance().getTextureHeight("panel");
     if (panelHeight == 0) {
         panelHeight = 32; // Fallback value
-        std::cerr << "Warning: Could not get panel height, using default 32px" << std::endl;
+        LOG_WARN("Could not get panel height, using default").field("height", panelHeight);
     }
     
     // Calculate viewport dimensions to use full window area above panel
     viewportWidth = WINDOW_WIDTH;
     viewportHeight = WINDOW_HEIGHT - panelHeight;
     
-    // Load levels file and initialize level
+    // Initialize level from the pack loaded above
     currentLevel = std::make_unique<Level>();
-    if (!LevelLoader::loadLevelsFile("assets/LEVELS.DAT")) {
-        std::cerr << "Failed to load levels file! Falling back to test level." << std::endl;
-        currentLevel->loadTestLevel();
-    } else {
-        // Load level 1
-        if (!currentLevel->loadFromFile(1)) {
-            std::cerr << "Failed to load level 1! Using test level." << std::endl;
-            currentLevel->loadTestLevel();
+    currentLevel->setInputProvider(&keyboardInput);
+    currentLevel->setLevelLoader(&levelLoader);
+    testLevelSeed = std::random_device()();
+    currentLevelNumber = 1;
+    bool levelPackLoaded;
+    {
+        StartupPhase phase("Wait for level pack");
+        levelPackLoaded = levelPack.get();
+    }
+    {
+        StartupPhase phase("Load level");
+        if (!levelPackLoaded) {
+            LOG_ERROR("Failed to load levels file, falling back to test level");
+            currentLevelNumber = 0;
+        } else if (!currentLevel->loadFromFile(currentLevelNumber)) {
+            // Load level 1
+            LOG_ERROR("Failed to load level, using test level").field("level", currentLevelNumber);
+            currentLevelNumber = 0;
         }
+        if (currentLevelNumber == 0) {
+            currentLevel->loadTestLevel(testLevelSeed);
+        }
+    }
+    
+    if (startupReport) {
+        Logger::getInstance().flush();  // Keep the table clear of queued log lines
+        trace.printReport();
+        trace.writeChromeTrace("startup_trace.json");
     }
     
-    std::cout << "Game initialized successfully!" << std::endl;
+    LOG_INFO("Game initialized");
     return true;
 }
 
@@ -92,45 +167,307 @@ void Game::run() {
     currentState = GameState::PLAYING;
     
     auto lastTime = std::chrono::high_resolution_clock::now();
+    tickAccumulator = 0.0f;
     
     while (isRunning) {
         auto currentTime = std::chrono::high_resolution_clock::now();
-        float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
+        float frameTime = std::chrono::duration<float>(currentTime - lastTime).count();
         lastTime = currentTime;
         
+        Profiler::getInstance().beginFrame();
         handleEvents();
-        update(deltaTime);
-        render();
+        
+        // Advance the simulation in fixed ticks, independent of the render rate
+        tickAccumulator += frameTime;
+        int ticks = 0;
+        while (tickAccumulator >= tickDuration && ticks < MAX_TICKS_PER_FRAME) {
+            update(tickDuration);
+            tickAccumulator -= tickDuration;
+            ticks++;
+        }
+        
+        // After a long stall, drop the backlog instead of bursting physics
+        if (ticks == MAX_TICKS_PER_FRAME && tickAccumulator >= tickDuration) {
+            tickAccumulator = 0.0f;
+        }
+        
+        bool drawn = render(tickAccumulator / tickDuration);
+        Profiler::getInstance().endFrame();
+        
+        if (Profiler::getInstance().isOverlayVisible()) {
+            updateProfilerTitle();
+        }
+        
+        // An unchanged frame isn't presented, so there's no vsync to pace the
+        // loop; sleep until the next tick is due or input arrives instead
+        if (!drawn) {
+            waitForNextTick();
+        }
+    }
+}
+
+void Game::waitForNextTick() {
+    int timeoutMs = static_cast<int>((tickDuration - tickAccumulator) * 1000.0f);
+    if (timeoutMs <= 0) return;
+    
+    SDL_Event event;
+    if (SDL_WaitEventTimeout(&event, timeoutMs)) {
+        handleEvent(event);
     }
 }
 
 void Game::handleEvents() {
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
-        switch (event.type) {
-            case SDL_QUIT:
+        handleEvent(event);
+    }
+}
+
+void Game::handleEvent(const SDL_Event& event) {
+    switch (event.type) {
+        case SDL_QUIT:
+            isRunning = false;
+            break;
+        case SDL_WINDOWEVENT:
+            // The window contents may be gone; the next frame has to be drawn
+            if (event.window.event == SDL_WINDOWEVENT_EXPOSED ||
+                event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED ||
+                event.window.event == SDL_WINDOWEVENT_RESTORED) {
+                redrawRequested = true;
+            }
+            break;
+        case SDL_RENDER_DEVICE_RESET:
+            // Every texture is gone, not just the render targets' contents
+            if (!AssetManager::getInstance().reloadTextures()) {
+                LOG_ERROR("Failed to reload textures after a render device reset");
+            }
+            if (currentLevel) {
+                currentLevel->invalidateStaticLayer(true);
+            }
+            redrawRequested = true;
+            break;
+        case SDL_RENDER_TARGETS_RESET:
+            // The static layer's contents are gone; a settled level would
+            // otherwise never redraw it
+            if (currentLevel) {
+                currentLevel->invalidateStaticLayer(false);
+            }
+            redrawRequested = true;
+            break;
+        case SDL_KEYDOWN:
+            if (event.key.keysym.sym == SDLK_ESCAPE) {
                 isRunning = false;
-                break;
-            case SDL_KEYDOWN:
-                if (event.key.keysym.sym == SDLK_ESCAPE) {
-                    isRunning = false;
-                } else if (currentState == GameState::PLAYING && currentLevel) {
-                    MurphyObject* murphy = currentLevel->getMurphy();
-                    if (murphy) {
-                        murphy->handleInput(event, currentLevel.get());
-                    }
+            } else if (event.key.keysym.sym == SDLK_F1) {
+                Profiler::getInstance().toggleOverlay();
+                redrawRequested = true;
+                if (!Profiler::getInstance().isOverlayVisible()) {
+                    SDL_SetWindowTitle(window, WINDOW_TITLE);
                 }
-                break;
-        }
+            } else if (event.key.keysym.sym == SDLK_F2) {
+                Profiler::getInstance().writeCsv("profile.csv");
+            } else if (event.key.keysym.sym == SDLK_F5) {
+                toggleRecording();
+            } else if (event.key.keysym.sym == SDLK_F6) {
+                if (player) {
+                    stopPlayback();
+                } else {
+                    startPlayback();
+                }
+            } else if (event.key.keysym.sym == SDLK_F7) {
+                quickSave();
+            } else if (event.key.keysym.sym == SDLK_F8) {
+                quickLoad();
+            } else if (event.key.keysym.sym == SDLK_F4) {
+                showHint();
+            } else if (event.key.keysym.sym == SDLK_F3) {
+                if (Profiler::getInstance().isTracing()) {
+                    Profiler::getInstance().stopTrace("profile_trace.json");
+                } else {
+                    Profiler::getInstance().startTrace();
+                }
+            } else if (currentState == GameState::PLAYING && currentLevel) {
+                MurphyObject* murphy = currentLevel->getMurphy();
+                if (murphy) {
+                    murphy->handleInput(event, currentLevel.get());
+                }
+            }
+            break;
     }
 }
 
 void Game::update(float deltaTime) {
     if (currentState == GameState::PLAYING) {
         if (currentLevel) {
-            currentLevel->update(deltaTime);
+            const Uint8* keystate = SDL_GetKeyboardState(NULL);
+            bool canRewind = !isRecording && !player;
+            
+            if (canRewind && keystate[SDL_SCANCODE_BACKSPACE]) {
+                if (rewindHistory.pop(tickSnapshot)) {
+                    currentLevel->restoreSnapshot(tickSnapshot);
+                }
+            } else {
+                if (canRewind) {
+                    currentLevel->saveSnapshot(tickSnapshot);
+                    rewindHistory.push(tickSnapshot);
+                }
+                currentLevel->update(deltaTime);
+            }
             updateCamera(deltaTime);
         }
+        
+        if (player && player->isFinished()) {
+            stopPlayback();
+        }
+    }
+}
+
+bool Game::restartLevel() {
+    tickAccumulator = 0.0f;
+    rewindHistory.clear();
+    clearHint();
+    if (currentLevelNumber == 0) {
+        currentLevel->loadTestLevel(testLevelSeed);
+        return true;
+    }
+    return currentLevel->loadFromFile(currentLevelNumber);
+}
+
+void Game::toggleRecording() {
+    if (!currentLevel || player) return;
+    
+    if (isRecording) {
+        isRecording = false;
+        currentLevel->setInputProvider(&keyboardInput);
+        if (recording.save(RECORDING_PATH)) {
+            LOG_INFO("Saved recording").field("ticks", recording.inputs.size()).field("path", RECORDING_PATH);
+        }
+        return;
+    }
+    
+    // Recordings always start from a freshly loaded level
+    recording = Replay();
+    recording.levelNumber = static_cast<uint16_t>(currentLevelNumber);
+    recording.seed = testLevelSeed;
+    recording.tickRate = static_cast<uint16_t>(tickRate);
+    if (!restartLevel()) return;
+    
+    currentLevel->setInputProvider(&recorder);
+    isRecording = true;
+    LOG_INFO("Recording").field("level", currentLevelNumber);
+}
+
+void Game::startPlayback() {
+    if (!currentLevel || isRecording) return;
+    if (!playback.load(RECORDING_PATH)) return;
+    
+    if (playback.tickRate != tickRate) {
+        LOG_ERROR("Replay tick rate doesn't match the game").field("replay_hz", playback.tickRate).field("game_hz", tickRate);
+        return;
+    }
+    
+    player = std::make_unique<ReplayPlayer>(&playback, currentLevel.get());
+    if (!player->restart()) {
+        stopPlayback();
+        return;
+    }
+    
+    tickAccumulator = 0.0f;
+    rewindHistory.clear();
+    LOG_INFO("Playing back").field("ticks", player->getLength()).field("path", RECORDING_PATH);
+}
+
+void Game::stopPlayback() {
+    player.reset();
+    if (currentLevel) {
+        currentLevel->setInputProvider(&keyboardInput);
+    }
+}
+
+void Game::quickSave() {
+    if (!currentLevel || isRecording || player) return;
+    
+    currentLevel->saveSnapshot(quickSaveSnapshot);
+    LOG_INFO("Quick saved").field("bytes", quickSaveSnapshot.size());
+}
+
+void Game::showHint() {
+    if (!currentLevel) return;
+    
+    hintSolver.load(*currentLevel);
+    LevelSolver::Cell start = hintSolver.getStart();
+    LevelSolver::Cell target = hintSolver.findNearestInfotron(start);
+    redrawRequested = true;
+    if (target == LevelSolver::NO_CELL || !hintSolver.findPath(start, target, hintPath) || hintPath.empty()) {
+        clearHint();
+        char title[128];
+        snprintf(title, sizeof(title), "%s | hint: no infotron reachable without moving zonks", WINDOW_TITLE);
+        SDL_SetWindowTitle(window, title);
+        LOG_INFO("Hint: no infotron reachable without moving zonks");
+        return;
+    }
+    hintStart = start;
+    
+    int dx = LevelSolver::cellX(hintPath[0]) - LevelSolver::cellX(start);
+    int dy = LevelSolver::cellY(hintPath[0]) - LevelSolver::cellY(start);
+    const char* firstMove = dx > 0 ? "right" : dx < 0 ? "left" : dy > 0 ? "down" : "up";
+    char title[128];
+    snprintf(title, sizeof(title), "%s | hint: go %s, infotron at (%d, %d), %d steps", WINDOW_TITLE, firstMove,
+             LevelSolver::cellX(target), LevelSolver::cellY(target), static_cast<int>(hintPath.size()));
+    SDL_SetWindowTitle(window, title);
+    LOG_INFO("Hint").field("infotron_x", LevelSolver::cellX(target)).field("infotron_y", LevelSolver::cellY(target))
+        .field("steps", hintPath.size()).field("first_move", firstMove);
+}
+
+void Game::clearHint() {
+    if (hintStart == LevelSolver::NO_CELL) return;
+    
+    hintStart = LevelSolver::NO_CELL;
+    hintPath.clear();
+    redrawRequested = true;
+    if (!Profiler::getInstance().isOverlayVisible()) {
+        SDL_SetWindowTitle(window, WINDOW_TITLE);
+    }
+}
+
+void Game::renderHint(float viewX, float viewY) {
+    if (hintStart == LevelSolver::NO_CELL || !currentLevel) return;
+    
+    // The path starts where Murphy stood, so any move makes it stale
+    MurphyObject* murphy = currentLevel->getMurphy();
+    if (!murphy || LevelSolver::cellAt(murphy->getX(), murphy->getY()) != hintStart) {
+        clearHint();
+        return;
+    }
+    
+    const int tile = Level::TILE_SIZE;
+    SDL_SetRenderDrawBlendMode(sdlRenderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(sdlRenderer, 0xE0, 0xE0, 0x40, 0xC0);
+    
+    // A dot per step, the first one bigger so the direction to go stands out
+    for (size_t i = 0; i < hintPath.size(); i++) {
+        int size = i == 0 ? 8 : 4;
+        SDL_Rect dot = {LevelSolver::cellX(hintPath[i]) * tile - static_cast<int>(viewX) + (tile - size) / 2,
+                        LevelSolver::cellY(hintPath[i]) * tile - static_cast<int>(viewY) + (tile - size) / 2,
+                        size, size};
+        SDL_RenderFillRect(sdlRenderer, &dot);
+    }
+    
+    // Box around the infotron at the end of the path
+    LevelSolver::Cell target = hintPath.back();
+    SDL_Rect targetRect = {LevelSolver::cellX(target) * tile - static_cast<int>(viewX),
+                           LevelSolver::cellY(target) * tile - static_cast<int>(viewY), tile, tile};
+    SDL_RenderDrawRect(sdlRenderer, &targetRect);
+    
+    SDL_SetRenderDrawBlendMode(sdlRenderer, SDL_BLENDMODE_NONE);
+    PROFILE_COUNT(DRAW_CALLS, static_cast<uint32_t>(hintPath.size()) + 1);
+}
+
+void Game::quickLoad() {
+    if (!currentLevel || isRecording || player || quickSaveSnapshot.empty()) return;
+    
+    if (currentLevel->restoreSnapshot(quickSaveSnapshot)) {
+        rewindHistory.clear();
+        LOG_INFO("Quick loaded");
     }
 }
 
@@ -159,6 +496,9 @@ void Game::updateCamera(float deltaTime) {
     targetCameraX = std::max(-8.0f, std::min(targetCameraX, maxCameraX));
     targetCameraY = std::max(-8.0f, std::min(targetCameraY, maxCameraY));  // Remove shift adjustment
     
+    prevCameraX = cameraX;
+    prevCameraY = cameraY;
+    
     // Smooth camera following
     float cameraSpeed = 8.0f;
     cameraX += (targetCameraX - cameraX) * cameraSpeed * deltaTime;
@@ -169,7 +509,25 @@ void Game::updateCamera(float deltaTime) {
     cameraY = roundf(cameraY);
 }
 
-void Game::render() {
+bool Game::render(float alpha) {
+    // Interpolate the camera between ticks, staying pixel-aligned
+    float viewX = roundf(prevCameraX + (cameraX - prevCameraX) * alpha);
+    float viewY = roundf(prevCameraY + (cameraY - prevCameraY) * alpha);
+    
+    // Skip frames that would come out identical to what's on screen
+    if (!needsRedraw(viewX, viewY)) {
+        return false;
+    }
+    redrawRequested = false;
+    drawnViewX = viewX;
+    drawnViewY = viewY;
+    drawnRevision = currentLevel ? currentLevel->getRevision() : 0;
+    
+    // Bring the cached static tiles up to date before touching the backbuffer
+    if (currentState == GameState::PLAYING && currentLevel) {
+        currentLevel->updateStaticLayer(spriteBatch);
+    }
+    
     // Clear screen with dark background
     SDL_SetRenderDrawColor(sdlRenderer, 0x00, 0x00, 0x00, 0xFF);
     SDL_RenderClear(sdlRenderer);
@@ -181,7 +539,8 @@ void Game::render() {
         SDL_RenderSetClipRect(sdlRenderer, &levelViewport);
         
         // Render level content within the clipped viewport
-        renderLevelWithOffset();
+        renderLevelWithOffset(viewX, viewY, alpha);
+        renderHint(viewX, viewY);
         
         // Reset viewport and clip for UI elements
         SDL_RenderSetViewport(sdlRenderer, nullptr);
@@ -189,16 +548,34 @@ void Game::render() {
         
         // Render panel (UI layer on top)
         renderPanel();
+        
+        // Profiler overlay sits over the top of the level view
+        Profiler::getInstance().renderOverlay(sdlRenderer, 0, 0, WINDOW_WIDTH, 48);
     }
     
+    PROFILE_COUNT(DRAW_CALLS, spriteBatch.takeSubmitCount());
+    
     // Present the back buffer
+    PROFILE_SCOPE(PRESENT);
     SDL_RenderPresent(sdlRenderer);
+    return true;
+}
+
+bool Game::needsRedraw(float viewX, float viewY) const {
+    if (redrawRequested || Profiler::getInstance().isOverlayVisible()) {
+        return true;
+    }
+    if (currentState != GameState::PLAYING || !currentLevel) {
+        return false;
+    }
+    return !currentLevel->isSettled() || currentLevel->getRevision() != drawnRevision ||
+           viewX != drawnViewX || viewY != drawnViewY;
 }
 
-void Game::renderLevelWithOffset() {
+void Game::renderLevelWithOffset(float viewX, float viewY, float alpha) {
     // Calculate which tiles are visible - expand to include borders
-    int startTileX = static_cast<int>(cameraX / 16) - 2;  // Extra margin for borders
-    int startTileY = static_cast<int>(cameraY / 16) - 2;  // Extra margin for borders
+    int startTileX = static_cast<int>(viewX / 16) - 2;  // Extra margin for borders
+    int startTileY = static_cast<int>(viewY / 16) - 2;  // Extra margin for borders
     int endTileX = startTileX + (viewportWidth / 16) + 4;   // More tiles for borders
     int endTileY = startTileY + (viewportHeight / 16) + 4;  // More tiles for borders
     
@@ -210,17 +587,52 @@ void Game::renderLevelWithOffset() {
     
     // Render visible tiles and borders with camera offset
     if (currentLevel) {
-        currentLevel->renderRegion(sdlRenderer, startTileX, startTileY, endTileX, endTileY, -cameraX, -cameraY);
+        currentLevel->renderRegion(spriteBatch, startTileX, startTileY, endTileX, endTileY, -viewX, -viewY, alpha);
     }
+    
+    // Submit the whole level while the level viewport and clip are still set
+    spriteBatch.flush();
 }
 
 void Game::renderPanel() {
-    SDL_Texture* panelTexture = AssetManager::getInstance().getTexture("panel");
-    if (panelTexture) {
+    PROFILE_SCOPE(RENDER_PANEL);
+    
+    SDL_Texture* texture = AssetManager::getInstance().getTexture(panelTexture);
+    if (texture) {
         // Render panel at the bottom using dynamic height
         SDL_Rect panelRect = {0, WINDOW_HEIGHT - panelHeight, WINDOW_WIDTH, panelHeight};
-        SDL_RenderCopy(sdlRenderer, panelTexture, nullptr, &panelRect);
+        SDL_RenderCopy(sdlRenderer, texture, nullptr, &panelRect);
+        PROFILE_COUNT(DRAW_CALLS, 1);
+    }
+}
+
+void Game::updateProfilerTitle() {
+    // No font rendering yet, so the overlay's numbers go in the window title
+    static const int TITLE_INTERVAL = 30;
+    static int framesUntilUpdate = 0;
+    if (--framesUntilUpdate > 0) return;
+    framesUntilUpdate = TITLE_INTERVAL;
+    
+    const Profiler& profiler = Profiler::getInstance();
+    const ProfileFrame& frame = profiler.getLastFrame();
+    char title[320];
+    int length = snprintf(title, sizeof(title), "%s | frame %.2f ms | update %.2f ms | render %.2f ms | present %.2f ms | %u draws | %u lookups | %u updated",
+             WINDOW_TITLE,
+             frame.sectionMs[static_cast<size_t>(ProfileSection::FRAME)],
+             frame.sectionMs[static_cast<size_t>(ProfileSection::LEVEL_UPDATE)],
+             frame.sectionMs[static_cast<size_t>(ProfileSection::RENDER_REGION)],
+             frame.sectionMs[static_cast<size_t>(ProfileSection::PRESENT)],
+             frame.counters[static_cast<size_t>(ProfileCounter::DRAW_CALLS)],
+             frame.counters[static_cast<size_t>(ProfileCounter::GET_OBJECT_AT)],
+             frame.counters[static_cast<size_t>(ProfileCounter::OBJECTS_UPDATED)]);
+    
+    // A steady game loop should show 0 here, with only the odd warm-up frame allocating
+    if (AllocationCounter::isEnabled() && length > 0 && static_cast<size_t>(length) < sizeof(title)) {
+        snprintf(title + length, sizeof(title) - length, " | %u allocs | %d/%d frames allocated",
+                 frame.counters[static_cast<size_t>(ProfileCounter::HEAP_ALLOCATIONS)],
+                 profiler.getAllocatingFrameCount(), profiler.getHistoryCount());
     }
+    SDL_SetWindowTitle(window, title);
 }
 
 void Game::cleanup() {
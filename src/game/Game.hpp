@@ -2,6 +2,13 @@
 #define GAME_HPP
 
 #include "../main.hpp"
+#include "../systems/AssetManager.hpp"
+#include "../systems/InputProvider.hpp"
+#include "../systems/SpriteBatch.hpp"
+#include "LevelLoader.hpp"
+#include "LevelSolver.hpp"
+#include "Replay.hpp"
+#include "SnapshotRing.hpp"
 #include <memory>
 
 // Forward declarations
@@ -17,38 +24,104 @@ public:
     void run();
     void cleanup();
     
+    // Simulation rate in ticks per second (defaults to the original game's 35 Hz)
+    void setTickRate(int ticksPerSecond);
+    
+    // Print the startup phase table and write startup_trace.json once loaded
+    void setStartupReport(bool enabled) { startupReport = enabled; }
+    
 private:
     void handleEvents();
     void update(float deltaTime);
-    void render();
+    void handleEvent(const SDL_Event& event);
+    void waitForNextTick();
+    bool render(float alpha);  // false when the frame was skipped as unchanged
+    bool needsRedraw(float viewX, float viewY) const;
     void renderPanel();
-    void renderLevelWithOffset();
+    void updateProfilerTitle();
+    
+    // Replays
+    bool restartLevel();
+    void toggleRecording();
+    void startPlayback();
+    void stopPlayback();
+    
+    // Rewind and quick save/load
+    void quickSave();
+    void quickLoad();
+    void showHint();
+    void clearHint();
+    void renderHint(float viewX, float viewY);
+    void renderLevelWithOffset(float viewX, float viewY, float alpha);
     void updateCamera(float deltaTime);
     
     SDL_Window* window;
     SDL_Renderer* sdlRenderer;
+    SpriteBatch spriteBatch;  // Level tiles, borders and objects go out in one submission
     
     GameState currentState;
     bool isRunning;
     
     // Game objects
+    LevelLoader levelLoader;
     std::unique_ptr<Level> currentLevel;
+    int currentLevelNumber;  // 0 for the random test level
+    uint32_t testLevelSeed;
+    KeyboardInputProvider keyboardInput;
+    
+    // F5 records from a fresh start of the current level, F6 plays it back
+    Replay recording;
+    ReplayRecorder recorder;
+    bool isRecording;
+    Replay playback;
+    std::unique_ptr<ReplayPlayer> player;
     // Remove: std::unique_ptr<Player> player;
     
+    // Hold Backspace to rewind one tick per tick; F7/F8 quick save/load in memory.
+    // Both are off while recording or playing back, since they'd break the replay.
+    SnapshotRing rewindHistory;
+    std::vector<uint8_t> tickSnapshot;  // Scratch buffer, reused every tick
+    std::vector<uint8_t> quickSaveSnapshot;
+    
+    // F4 shows the way to the nearest infotron: the path is drawn over the
+    // level and the first move goes in the window title, until Murphy moves
+    LevelSolver hintSolver;
+    std::vector<LevelSolver::Cell> hintPath;
+    LevelSolver::Cell hintStart;  // Murphy's cell when the hint was made; NO_CELL when none is shown
+    
     // Camera/viewport
     float cameraX, cameraY;
+    float prevCameraX, prevCameraY;  // Camera at the start of the last tick
+    
+    // Change tracking for skipping unchanged frames: what the last presented
+    // frame showed, plus a flag for window events that lose the contents
+    bool redrawRequested;
+    uint64_t drawnRevision;
+    float drawnViewX, drawnViewY;
+    
+    bool startupReport;
+    
+    // Fixed-timestep simulation
+    int tickRate;
+    float tickDuration;
+    float tickAccumulator;
     
     // Constants matching original Supaplex
     static const int WINDOW_WIDTH = 320;
     static const int WINDOW_HEIGHT = 200;
     static const int SCALE_FACTOR = 2;  // Scale up for modern displays
+    static const int DEFAULT_TICK_RATE = 35;  // Original game's simulation rate
+    static const int MAX_TICKS_PER_FRAME = 5;  // Drop time beyond this after a hitch
+    static const int REWIND_SECONDS = 10;
     
     // Dynamic viewport dimensions
     int viewportWidth;
     int viewportHeight;
     int panelHeight;
+    AssetManager::TextureHandle panelTexture;
     
     static const char* WINDOW_TITLE;
+    static const char* RECORDING_PATH;
 };
 
 #endif // GAME_HPP
\ No newline at end of file
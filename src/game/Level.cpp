@@ -1,36 +1,62 @@
 #include "Level.hpp"
 #include "LevelLoader.hpp"
-#include "../systems/AssetManager.hpp"
+#include "../systems/Log.hpp"
+#include "../systems/Profiler.hpp"
+#include "../systems/StateStream.hpp"
 #include <algorithm>
 #include <random>
 
-Level::Level() : murphy(nullptr) {
-    // Initialize border sprite
-    SDL_Texture* spriteTexture = AssetManager::getInstance().getTexture("sprites");
-    if (spriteTexture) {
-        borderSprite = BorderSprite(spriteTexture, SPRITE_BORDER_CORNERS);
-    }
+Level::Level() : murphy(nullptr), inputProvider(nullptr), levelLoader(nullptr), staticLayer(nullptr), staticLayerValid(false), revision(0) {
+    grid.fill(EntityStore::NO_SLOT);
+    cellDirty.fill(false);
+    dirtyCells.reserve(LEVEL_WIDTH * LEVEL_HEIGHT);  // Each cell is queued at most once
+    store.reserve(LEVEL_WIDTH * LEVEL_HEIGHT + 1);  // One object per cell plus Murphy
 }
 
 Level::~Level() {
+    clearAllObjects();
+    
+    if (staticLayer) {
+        SDL_DestroyTexture(staticLayer);
+    }
 }
 
 bool Level::loadFromFile(int levelNumber) {
-    return LevelLoader::loadLevel(this, levelNumber);
+    if (!levelLoader) {
+        LOG_ERROR("No level pack loaded");
+        return false;
+    }
+    return levelLoader->loadLevel(this, levelNumber);
 }
 
 void Level::clearAllObjects() {
-    objects.clear();
+    // Drop from the back so no rows get moved around
+    while (store.size() > 0) {
+        destroyObject(static_cast<Slot>(store.size() - 1));
+    }
+    
+    // Keep pool memory around for the next level
+    basePool.reset();
+    infotronPool.reset();
+    zonkPool.reset();
+    chipPool.reset();
+    murphyPool.reset();
+    
+    awakeSlots.clear();
+    grid.fill(EntityStore::NO_SLOT);
+    clearCellMasks();
     murphy = nullptr;
+    
+    // Everything changed, rebuild the static layer from scratch
+    staticLayerValid = false;
+    revision++;
 }
 
-void Level::loadTestLevel() {
-    objects.clear();
-    murphy = nullptr;
+void Level::loadTestLevel(uint32_t seed) {
+    clearAllObjects();
     
-    // Random number generation
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    // Random number generation, seeded so replays can rebuild the same level
+    std::mt19937 gen(seed);
     std::uniform_real_distribution<> dis(0.0, 1.0);
     
     // Fill level with randomly placed BASE and INFOTRON objects
@@ -45,10 +71,10 @@ void Level::loadTestLevel() {
             
             if (random < 0.7) {
                 // 70% chance for BASE object
-                objects.push_back(std::make_unique<BaseObject>(x, y));
+                createObject(ObjectType::BASE, x, y);
             } else if (random < 0.85) {
                 // 15% chance for INFOTRON object
-                objects.push_back(std::make_unique<InfotronObject>(x, y));
+                createObject(ObjectType::INFOTRON, x, y);
             }
             // 15% chance for empty space (no object created)
         }
@@ -59,94 +85,527 @@ void Level::loadTestLevel() {
 }
 
 void Level::spawnMurphy(int x, int y) {
-    auto murphyObj = std::make_unique<MurphyObject>(x, y);
-    murphy = murphyObj.get(); // Keep direct pointer
-    objects.push_back(std::move(murphyObj));
+    murphy = murphyPool.create(store, x, y); // Keep direct pointer
+    addObject(murphy);
 }
 
 void Level::moveObject(GameObject* obj, int newX, int newY) {
     if (!obj) return;
     
-    // Update the object's position
+    int oldX = obj->getX();
+    int oldY = obj->getY();
+    
+    // Update the object's position, keeping the occupancy grid in sync
+    removeFromGrid(obj->getSlot());
     obj->setPosition(newX, newY);
+    placeInGrid(obj->getSlot());
+    
+    markCellDirty(oldX, oldY);
+    markCellDirty(newX, newY);
+}
+
+void Level::placeInGrid(Slot slot) {
+    int x = store.getX(slot);
+    int y = store.getY(slot);
+    if (store.getType(slot) == ObjectType::PLAYER || !inBounds(x, y)) {
+        return;
+    }
+    
+    // First occupant wins, matching the old first-match scan over objects
+    int index = cellIndex(x, y);
+    if (grid[index] == EntityStore::NO_SLOT || !store.hasFlag(grid[index], EntityStore::ACTIVE)) {
+        grid[index] = slot;
+        setCellMasks(x, y, slot);
+    }
+}
+
+void Level::removeFromGrid(Slot slot) {
+    int x = store.getX(slot);
+    int y = store.getY(slot);
+    if (!inBounds(x, y)) {
+        return;
+    }
+    
+    int index = cellIndex(x, y);
+    if (grid[index] == slot) {
+        grid[index] = EntityStore::NO_SLOT;
+        setCellMasks(x, y, EntityStore::NO_SLOT);
+    }
+}
+
+void Level::setCellMasks(int x, int y, Slot slot) {
+    occupiedCells.reset(x, y);
+    zonkCells.reset(x, y);
+    infotronCells.reset(x, y);
+    baseCells.reset(x, y);
+    solidCells.reset(x, y);
+    movingZonkCells.reset(x, y);
+    if (slot == EntityStore::NO_SLOT) return;
+    
+    occupiedCells.set(x, y);
+    switch (store.getType(slot)) {
+        case ObjectType::BASE: baseCells.set(x, y); break;
+        case ObjectType::INFOTRON: infotronCells.set(x, y); break;
+        case ObjectType::ZONK:
+            zonkCells.set(x, y);
+            solidCells.set(x, y);
+            if (store.hasFlag(slot, EntityStore::BUSY)) {  // Falling or rolling
+                movingZonkCells.set(x, y);
+            }
+            break;
+        default: solidCells.set(x, y); break;
+    }
+}
+
+void Level::clearCellMasks() {
+    occupiedCells.clear();
+    zonkCells.clear();
+    infotronCells.clear();
+    baseCells.clear();
+    solidCells.clear();
+    reserved.clear();
+    movedThisPass.clear();
+    movingZonkCells.clear();
 }
 
 void Level::update(float deltaTime) {
-    // Store positions of objects that will be removed this frame (for digging)
-    std::vector<std::pair<int, int>> removedPositions;
+    PROFILE_SCOPE(LEVEL_UPDATE);
+    
+    // Anything awake at the start of the tick may look different at the end,
+    // including the tick where it comes to rest
+    bool wasSettled = isSettled();
     
-    // Process Murphy's input first
+    // Process Murphy's input first. Input is polled exactly once per tick,
+    // even without Murphy, so recorded inputs stay aligned with ticks.
     if (murphy && murphy->isActive()) {
         murphy->processInput(this);
+    } else {
+        pollInput();
     }
     
-    // Update all objects and provide level reference for zonks
-    for (auto& object : objects) {
-        if (object && object->isActive()) {
-            bool wasActive = object->isActive();
-            
-            // Give zonks access to the level for gravity checks
-            if (object->getType() == ObjectType::ZONK) {
-                ZonkObject* zonk = static_cast<ZonkObject*>(object.get());
-                zonk->setLevel(this);
-            }
-            
-            object->update(deltaTime);
-            
-            // Check if object became inactive this frame (from digging, not Murphy movement)
-            if (wasActive && !object->isActive() && object->getType() != ObjectType::PLAYER) {
-                removedPositions.push_back({object->getX(), object->getY()});
-            }
+    // Update awake objects. Objects
+    // woken during this pass are appended and first update next frame.
+    size_t awakeCount = awakeSlots.size();
+    for (size_t i = 0; i < awakeCount; i++) {
+        Slot slot = awakeSlots[i];
+        if (!store.hasFlag(slot, EntityStore::ACTIVE)) {
+            continue;
         }
+        
+        store.getObject(slot)->update(deltaTime);
+        PROFILE_COUNT(OBJECTS_UPDATED, 1);
     }
     
+    // Drop objects that went idle or inactive from the active set; idle ones
+    // belong to the static layer again
+    awakeSlots.erase(
+        std::remove_if(awakeSlots.begin(), awakeSlots.end(),
+            [this](Slot slot) {
+                uint8_t flags = store.getFlags(slot);
+                if ((flags & EntityStore::ACTIVE) && (flags & EntityStore::BUSY)) {
+                    return false;
+                }
+                store.setFlag(slot, EntityStore::AWAKE, false);
+                markCellDirty(store.getX(slot), store.getY(slot));
+                return true;
+            }),
+        awakeSlots.end());
+    
     // Clean up inactive objects
     cleanupInactiveObjects();
     
-    // Trigger gravity checks only for objects removed by digging, not Murphy movement
-    for (const auto& pos : removedPositions) {
-        triggerGravityCheckAbove(pos.first, pos.second);
+    // Zonks react to everything that moved or disappeared this tick
+    updateGravity(deltaTime);
+    
+    if (!wasSettled || !isSettled()) {
+        revision++;
     }
 }
 
-void Level::triggerGravityCheckAbove(int x, int y) {
-    // Check all objects above this position for zonks that might need to fall
-    for (int checkY = y - 1; checkY >= 0; checkY--) {
-        GameObject* obj = getObjectAt(x, checkY);
-        if (obj && obj->getType() == ObjectType::ZONK) {
-            ZonkObject* zonk = static_cast<ZonkObject*>(obj);
-            if (!zonk->isFalling()) {
-                // Force an immediate gravity check
-                zonk->setLevel(this);
-                zonk->forceGravityCheck();
+void Level::updateGravity(float deltaTime) {
+    PROFILE_SCOPE(GRAVITY);
+    
+    movedThisPass.clear();
+    
+    // Bottom-up like the original engine: a zonk falling lands in a row that
+    // was already swept, and a zonk above sees the cell below as it is after
+    // this tick. Within a row only zonks that are moving or could start to
+    // are visited, left to right; resting piles cost a few ops per row.
+    for (int y = LEVEL_HEIGHT - 1; y >= 0; y--) {
+        uint64_t pending = getGravityCandidates(y);
+        while (pending) {
+            int x = CellMask::lowestBit(pending);
+            pending &= pending - 1;
+            
+            ZonkObject* zonk = static_cast<ZonkObject*>(store.getObject(grid[cellIndex(x, y)]));
+            if (zonk->isMoving()) {
+                // Where it came from, before advanceMotion clears the state
+                int fromX = zonk->isFalling() ? x : x - zonk->getRollDirection();
+                int fromY = zonk->isFalling() ? y - 1 : y;
+                if (!zonk->advanceMotion(deltaTime)) {
+                    continue;
+                }
+                reserved.reset(fromX, fromY);
+                movingZonkCells.reset(x, y);
+                
+                // A finished roll frees a cell in this row, which may let a
+                // zonk further right go
+                if (fromY == y) {
+                    pending = getGravityCandidates(y) & ~((uint64_t(2) << x) - 1);
+                }
             }
-        } else if (obj) {
-            // Hit a solid object, no need to check further up
-            break;
+            
+            // Arrived or resting: see if it can go on
+            tryStartZonkMove(zonk);
         }
     }
 }
 
-GameObject* Level::getObjectAt(int x, int y) const {
-    for (const auto& object : objects) {
-        if (object && object->isActive() && object->getX() == x && object->getY() == y) {
-            return object.get();
+uint64_t Level::getGravityCandidates(int y) const {
+    uint64_t zonks = zonkCells.getRow(y) & ~movedThisPass.getRow(y);
+    uint64_t candidates = zonks & movingZonkCells.getRow(y);
+    if (y + 1 >= LEVEL_HEIGHT) {
+        return candidates;
+    }
+    
+    // Falls into a free cell below, or rolls off something round and still
+    // when the cell beside it and the one below that are both free. This is
+    // a superset: tryStartZonkMove makes the final call with the live state.
+    uint64_t freeBelow = getFreeRow(y + 1);
+    uint64_t roundBelow = (infotronCells.getRow(y + 1) | (zonkCells.getRow(y + 1) & ~movingZonkCells.getRow(y + 1))) &
+                          ~reserved.getRow(y + 1);
+    uint64_t sideFree = getFreeRow(y) & freeBelow;
+    return candidates | (zonks & (freeBelow | (roundBelow & ((sideFree >> 1) | (sideFree << 1)))));
+}
+
+void Level::tryStartZonkMove(ZonkObject* zonk) {
+    int x = zonk->getX();
+    int y = zonk->getY();
+    int belowY = y + 1;
+    if (belowY >= LEVEL_HEIGHT) return;
+    
+    int newX = x;
+    int newY = belowY;
+    int rollDirection = 0;
+    
+    if (!isCellFree(x, belowY)) {
+        // Resting on something round and still: roll off, right side first
+        bool round = infotronCells.test(x, belowY) ||
+                     (zonkCells.test(x, belowY) && !movingZonkCells.test(x, belowY));
+        if (!round || reserved.test(x, belowY)) return;
+        
+        if (isCellFree(x + 1, y) && isCellFree(x + 1, belowY)) {
+            rollDirection = 1;
+        } else if (isCellFree(x - 1, y) && isCellFree(x - 1, belowY)) {
+            rollDirection = -1;
+        } else {
+            return;
         }
+        newX = x + rollDirection;
+        newY = y;
+    }
+    
+    reserved.set(x, y);
+    moveObject(zonk, newX, newY);
+    movedThisPass.set(newX, newY);
+    
+    if (rollDirection != 0) {
+        zonk->startRolling(rollDirection);
+    } else {
+        zonk->startFalling();
+    }
+    movingZonkCells.set(newX, newY);
+    wakeObject(zonk);
+}
+
+bool Level::isCellFree(int x, int y) const {
+    return inBounds(x, y) && ((getFreeRow(y) >> x) & 1);
+}
+
+uint64_t Level::getMurphyRow(int y) const {
+    if (!murphy || !murphy->isActive() || murphy->getY() != y || !inBounds(murphy->getX(), y)) {
+        return 0;
+    }
+    return uint64_t(1) << murphy->getX();
+}
+
+uint64_t Level::getFreeRow(int y) const {
+    return ~(occupiedCells.getRow(y) | reserved.getRow(y) | getMurphyRow(y)) & CellMask::ROW_MASK;
+}
+
+GameObject* Level::getObjectAt(int x, int y) const {
+    PROFILE_COUNT(GET_OBJECT_AT, 1);
+    
+    if (!inBounds(x, y)) {
+        return nullptr;
+    }
+    
+    Slot slot = grid[cellIndex(x, y)];
+    if (slot != EntityStore::NO_SLOT && store.hasFlag(slot, EntityStore::ACTIVE)) {
+        return store.getObject(slot);
+    }
+    
+    // Murphy isn't stored in the grid
+    if (murphy && murphy->isActive() && murphy->getX() == x && murphy->getY() == y) {
+        return murphy;
     }
     return nullptr;
 }
 
 void Level::removeObjectAt(int x, int y) {
-    for (auto& object : objects) {
-        if (object && object->getX() == x && object->getY() == y) {
-            object->setActive(false);
-            break;
+    if (!inBounds(x, y)) {
+        return;
+    }
+    
+    // Murphy isn't in the grid, so his own pending BASE removal can't take him out
+    Slot slot = grid[cellIndex(x, y)];
+    if (slot != EntityStore::NO_SLOT) {
+        store.setFlag(slot, EntityStore::ACTIVE, false);
+    }
+}
+
+GameObject* Level::createObject(ObjectType type, int x, int y) {
+    GameObject* object = nullptr;
+    switch (type) {
+        case ObjectType::BASE: object = basePool.create(store, x, y); break;
+        case ObjectType::INFOTRON: object = infotronPool.create(store, x, y); break;
+        case ObjectType::ZONK: object = zonkPool.create(store, x, y); break;
+        case ObjectType::CHIP_1: object = chipPool.create(store, x, y); break;
+        case ObjectType::PLAYER:
+            spawnMurphy(x, y);
+            return murphy;
+        default:
+            return nullptr;  // Not implemented yet
+    }
+    
+    addObject(object);
+    return object;
+}
+
+void Level::reserveObjects(ObjectType type, size_t count) {
+    switch (type) {
+        case ObjectType::BASE: basePool.reserve(count); break;
+        case ObjectType::INFOTRON: infotronPool.reserve(count); break;
+        case ObjectType::ZONK: zonkPool.reserve(count); break;
+        case ObjectType::CHIP_1: chipPool.reserve(count); break;
+        case ObjectType::PLAYER: murphyPool.reserve(count); break;
+        default: break;
+    }
+    store.reserve(store.size() + count);
+}
+
+void Level::saveSnapshot(std::vector<uint8_t>& out) const {
+    out.clear();
+    StateWriter writer(out);
+    
+    writer.write(SNAPSHOT_MAGIC);
+    writer.write(SNAPSHOT_VERSION);
+    writer.write(static_cast<uint32_t>(store.size()));
+    
+    // Objects are referenced by their store slot from here on, which is also
+    // the order they are recreated in
+    for (size_t slot = 0; slot < store.size(); slot++) {
+        writer.write(static_cast<uint8_t>(store.getType(static_cast<Slot>(slot))));
+        writer.write(store.getX(static_cast<Slot>(slot)));
+        writer.write(store.getY(static_cast<Slot>(slot)));
+        store.getObject(static_cast<Slot>(slot))->saveState(writer);
+    }
+    writer.write(murphy ? static_cast<uint32_t>(murphy->getSlot()) : UINT32_MAX);
+    
+    // Update order matters for determinism, so keep the awake list as is
+    writer.write(static_cast<uint32_t>(awakeSlots.size()));
+    for (Slot slot : awakeSlots) {
+        writer.write(slot);
+    }
+    
+    for (Slot slot : grid) {
+        writer.write(slot);
+    }
+    for (int y = 0; y < LEVEL_HEIGHT; y++) {
+        for (int x = 0; x < LEVEL_WIDTH; x++) {
+            writer.write(reserved.test(x, y));
+        }
+    }
+}
+
+bool Level::restoreSnapshot(const uint8_t* data, size_t size) {
+    StateReader reader(data, size);
+    
+    uint32_t magic = 0;
+    uint8_t version = 0;
+    uint32_t objectCount = 0;
+    reader.read(magic);
+    reader.read(version);
+    reader.read(objectCount);
+    if (!reader.ok() || magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION) {
+        LOG_ERROR("Invalid level snapshot");
+        return false;
+    }
+    
+    // Cells still waiting to be redrawn don't match the layer; force them to differ
+    bool layerWasValid = staticLayerValid;
+    for (int index = 0; index < LEVEL_WIDTH * LEVEL_HEIGHT; index++) {
+        cellsBeforeRestore[index] = cellDirty[index] ? StaticCell{-2, 0.0f, 0.0f} : getStaticCell(index);
+    }
+    
+    clearAllObjects();
+    
+    for (uint32_t i = 0; i < objectCount; i++) {
+        uint8_t type = 0;
+        int x = 0, y = 0;
+        reader.read(type);
+        reader.read(x);
+        reader.read(y);
+        
+        GameObject* obj = reader.ok() ? createObject(static_cast<ObjectType>(type), x, y) : nullptr;
+        if (!obj || !obj->loadState(reader, this)) {
+            LOG_ERROR("Corrupt level snapshot").field("object", i);
+            clearAllObjects();
+            return false;
+        }
+    }
+    
+    uint32_t murphyIndex = UINT32_MAX;
+    reader.read(murphyIndex);
+    murphy = murphyIndex < store.size() && store.getType(static_cast<Slot>(murphyIndex)) == ObjectType::PLAYER
+                 ? static_cast<MurphyObject*>(store.getObject(static_cast<Slot>(murphyIndex)))
+                 : nullptr;
+    
+    // createObject woke and placed things its own way; replace both with the saved state
+    for (Slot slot : awakeSlots) {
+        store.setFlag(slot, EntityStore::AWAKE, false);
+    }
+    awakeSlots.clear();
+    
+    uint32_t awakeCount = 0;
+    reader.read(awakeCount);
+    for (uint32_t i = 0; i < awakeCount && reader.ok(); i++) {
+        Slot slot = EntityStore::NO_SLOT;
+        if (reader.read(slot) && slot < store.size()) {
+            store.setFlag(slot, EntityStore::AWAKE, true);
+            awakeSlots.push_back(slot);
+        }
+    }
+    
+    for (size_t cell = 0; cell < grid.size(); cell++) {
+        Slot slot = EntityStore::NO_SLOT;
+        reader.read(slot);
+        grid[cell] = slot < store.size() ? slot : EntityStore::NO_SLOT;
+    }
+    clearCellMasks();
+    for (int y = 0; y < LEVEL_HEIGHT; y++) {
+        for (int x = 0; x < LEVEL_WIDTH; x++) {
+            setCellMasks(x, y, grid[cellIndex(x, y)]);
+            
+            bool cellReserved = false;
+            reader.read(cellReserved);
+            if (cellReserved) {
+                reserved.set(x, y);
+            }
+        }
+    }
+    
+    if (!reader.ok() || !reader.atEnd()) {
+        LOG_ERROR("Corrupt level snapshot");
+        clearAllObjects();
+        return false;
+    }
+    
+    // Recreating the objects marked every cell; keep the layer and redraw
+    // only the cells that look different from before
+    for (int index : dirtyCells) {
+        cellDirty[index] = false;
+    }
+    dirtyCells.clear();
+    staticLayerValid = layerWasValid;
+    for (int index = 0; index < LEVEL_WIDTH * LEVEL_HEIGHT; index++) {
+        StaticCell before = cellsBeforeRestore[index];
+        StaticCell after = getStaticCell(index);
+        if (before.spriteId != after.spriteId || before.x != after.x || before.y != after.y) {
+            markCellDirty(index % LEVEL_WIDTH, index / LEVEL_WIDTH);
+        }
+    }
+    return true;
+}
+
+Level::StaticCell Level::getStaticCell(int index) const {
+    Slot slot = grid[index];
+    if (slot == EntityStore::NO_SLOT || (store.getFlags(slot) & (EntityStore::ACTIVE | EntityStore::AWAKE)) != EntityStore::ACTIVE) {
+        return {-1, 0.0f, 0.0f};
+    }
+    return {store.getSpriteId(slot), store.getRenderX(slot, 1.0f), store.getRenderY(slot, 1.0f)};
+}
+
+void Level::addObject(GameObject* object) {
+    // The object's constructor already appended its store row
+    placeInGrid(object->getSlot());
+    markCellDirty(object->getX(), object->getY());
+    if (!object->isIdle()) {
+        wakeObject(object);
+    }
+}
+
+void Level::destroyObject(Slot slot) {
+    GameObject* object = store.getObject(slot);
+    ObjectType type = store.getType(slot);
+    
+    // The last row moves into this slot; repoint the grid and the active set
+    Slot movedFrom = store.remove(slot);
+    if (movedFrom != EntityStore::NO_SLOT) {
+        int x = store.getX(slot);
+        int y = store.getY(slot);
+        if (inBounds(x, y) && grid[cellIndex(x, y)] == movedFrom) {
+            grid[cellIndex(x, y)] = slot;
         }
+        if (store.hasFlag(slot, EntityStore::AWAKE)) {
+            std::replace(awakeSlots.begin(), awakeSlots.end(), movedFrom, slot);
+        }
+    }
+    
+    // Return the object to the pool it came from
+    switch (type) {
+        case ObjectType::BASE: basePool.destroy(static_cast<BaseObject*>(object)); break;
+        case ObjectType::INFOTRON: infotronPool.destroy(static_cast<InfotronObject*>(object)); break;
+        case ObjectType::ZONK: zonkPool.destroy(static_cast<ZonkObject*>(object)); break;
+        case ObjectType::CHIP_1: chipPool.destroy(static_cast<ChipObject*>(object)); break;
+        case ObjectType::PLAYER: murphyPool.destroy(static_cast<MurphyObject*>(object)); break;
+        default: break;
     }
 }
 
-void Level::addObject(std::unique_ptr<GameObject> object) {
-    objects.push_back(std::move(object));
+void Level::wakeObject(GameObject* obj) {
+    if (!obj || obj->isAwake()) return;
+    
+    obj->setAwake(true);
+    awakeSlots.push_back(obj->getSlot());
+    
+    // Awake objects are drawn on top of the static layer, not in it
+    markCellDirty(obj->getX(), obj->getY());
+}
+
+void Level::markCellDirty(int x, int y) {
+    if (!inBounds(x, y)) return;
+    
+    revision++;
+    
+    int index = cellIndex(x, y);
+    if (!cellDirty[index]) {
+        cellDirty[index] = true;
+        dirtyCells.push_back(index);
+    }
+}
+
+bool Level::isSettled() const {
+    if (murphy && !murphy->isStill()) {
+        return false;
+    }
+    // Murphy never leaves the awake list; anything else in it is in motion
+    for (Slot slot : awakeSlots) {
+        if (!murphy || slot != murphy->getSlot()) {
+            return false;
+        }
+    }
+    return true;
 }
 
 void Level::digAt(int x, int y) {
@@ -156,9 +615,11 @@ void Level::digAt(int x, int y) {
     if (obj->getType() == ObjectType::BASE) {
         BaseObject* baseObj = static_cast<BaseObject*>(obj);
         baseObj->startDigging();
+        wakeObject(obj);
     } else if (obj->getType() == ObjectType::INFOTRON) {
         InfotronObject* infoObj = static_cast<InfotronObject*>(obj);
         infoObj->collect();
+        wakeObject(obj);
     } else if (obj->getType() == ObjectType::CHIP_1) {
         ChipObject* chipObj = static_cast<ChipObject*>(obj);
         chipObj->collect();
@@ -170,106 +631,15 @@ bool Level::isWalkable(int x, int y) const {
         return false;
     }
     
-    GameObject* obj = getObjectAt(x, y);
-    if (!obj) return true; // Empty space
+    // A cell a zonk is still moving out of is blocked until it has left
+    if (reserved.test(x, y)) return false;
     
-    // Can walk on BASE and INFOTRON (they get collected/dug)
-    // Zonks block movement (solid objects), but check if they're rolling
-    if (obj->getType() == ObjectType::ZONK) {
-        ZonkObject* zonk = static_cast<ZonkObject*>(obj);
-        return zonk->isRolling(); // Can walk through rolling zonks
-    }
-    
-    return obj->getType() == ObjectType::BASE || 
-           obj->getType() == ObjectType::INFOTRON;
-}
-
-void Level::renderRegion(SDL_Renderer* renderer, int startX, int startY, int endX, int endY, float offsetX, float offsetY) {
-    // Render borders first
-    renderBorders(renderer, startX, startY, endX, endY, offsetX, offsetY);
-    
-    // Then render level tiles
-    for (int y = startY; y < endY; y++) {
-        for (int x = startX; x < endX; x++) {
-            // Only render tiles within the actual level bounds (58x22)
-            if (x < 0 || x >= LEVEL_WIDTH || y < 0 || y >= LEVEL_HEIGHT) {
-                continue;
-            }
-            
-            GameObject* obj = getObjectAt(x, y);
-            if (obj && obj->isActive()) {
-                obj->render(renderer, offsetX, offsetY);
-            }
-        }
-    }
+    // Can walk on BASE and INFOTRON (they get collected/dug); zonks are solid
+    if (baseCells.test(x, y) || infotronCells.test(x, y)) return true;
+    if (solidCells.test(x, y) && store.hasFlag(grid[cellIndex(x, y)], EntityStore::ACTIVE)) return false;
     
-    // Ensure Murphy renders separately if he wasn't caught in the tile loop
-    if (murphy && murphy->isActive()) {
-        int murphyX = murphy->getX();
-        int murphyY = murphy->getY();
-        
-        // Always render Murphy if he's in the visible region
-        if (murphyX >= startX && murphyX < endX && murphyY >= startY && murphyY < endY) {
-            murphy->render(renderer, offsetX, offsetY);
-        }
-    }
-}
-
-void Level::renderBorders(SDL_Renderer* renderer, int startX, int startY, int endX, int endY, float offsetX, float offsetY) {
-    // Render borders for positions outside the 58x22 level area
-    for (int y = startY; y < endY; y++) {
-        for (int x = startX; x < endX; x++) {
-            // Only render borders outside the level bounds
-            bool isLeftBorder = (x == -1);
-            bool isRightBorder = (x == LEVEL_WIDTH);
-            bool isTopBorder = (y == -1);
-            bool isBottomBorder = (y == LEVEL_HEIGHT);
-            
-            // Skip if this is inside the level and not a border
-            if (!isLeftBorder && !isRightBorder && !isTopBorder && !isBottomBorder) {
-                continue;
-            }
-            
-            int spriteId;
-            int quarter;
-            bool shouldRender = true;
-            
-            // Determine border type and quarter based on position
-            if (isLeftBorder && isTopBorder) {
-                spriteId = SPRITE_BORDER_CORNERS;
-                quarter = 0;
-            } else if (isRightBorder && isTopBorder) {
-                spriteId = SPRITE_BORDER_CORNERS;
-                quarter = 1;
-            } else if (isLeftBorder && isBottomBorder) {
-                spriteId = SPRITE_BORDER_CORNERS;
-                quarter = 2;
-            } else if (isRightBorder && isBottomBorder) {
-                spriteId = SPRITE_BORDER_CORNERS;
-                quarter = 3;
-            } else if (isTopBorder) {
-                spriteId = SPRITE_BORDER_HORIZONTAL;
-                quarter = 2;
-            } else if (isBottomBorder) {
-                spriteId = SPRITE_BORDER_HORIZONTAL;
-                quarter = 0;
-            } else if (isLeftBorder) {
-                spriteId = SPRITE_BORDER_VERTICAL;
-                quarter = 0;
-            } else if (isRightBorder) {
-                spriteId = SPRITE_BORDER_VERTICAL;
-                quarter = 1;
-            } else {
-                shouldRender = false;
-            }
-            
-            if (shouldRender) {
-                int renderX = static_cast<int>((x * TILE_SIZE) + offsetX);
-                int renderY = static_cast<int>((y * TILE_SIZE) + offsetY);
-                borderSprite.renderWithSprite(renderer, renderX, renderY, spriteId, quarter);
-            }
-        }
-    }
+    // Empty space, or something already collected waiting for cleanup
+    return !((getMurphyRow(y) >> x) & 1);
 }
 
 void Level::cleanupInactiveObjects() {
@@ -278,11 +648,18 @@ void Level::cleanupInactiveObjects() {
         murphy = nullptr;
     }
     
-    // Remove inactive objects
-    objects.erase(
-        std::remove_if(objects.begin(), objects.end(),
-            [](const std::unique_ptr<GameObject>& obj) {
-                return !obj || !obj->isActive();
-            }),
-        objects.end());
+    // Release grid cells held by inactive objects before they are destroyed.
+    // Inactive objects are swapped with the last entry and their slot goes back
+    // to the pool for reuse, so nothing shifts
+    for (size_t i = 0; i < store.size();) {
+        Slot slot = static_cast<Slot>(i);
+        if (store.hasFlag(slot, EntityStore::ACTIVE)) {
+            i++;
+            continue;
+        }
+        
+        removeFromGrid(slot);
+        markCellDirty(store.getX(slot), store.getY(slot));
+        destroyObject(slot);
+    }
 }
\ No newline at end of file
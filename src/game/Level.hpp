@@ -2,35 +2,55 @@
 #define LEVEL_HPP
 
 #include "../main.hpp"
-#include "../systems/Sprite.hpp"
-#include "../systems/BorderSprite.hpp"
+#include "../systems/InputProvider.hpp"
+#include "../systems/ObjectPool.hpp"
 #include "../entities/GameObject.hpp"
 #include "../entities/BaseObject.hpp"
 #include "../entities/InfotronObject.hpp"
 #include "../entities/ZonkObject.hpp"
 #include "../entities/ChipObject.hpp"
 #include "../entities/MurphyObject.hpp"
+#include "BitGrid.hpp"
 #include <array>
 #include <vector>
 #include <memory>
 
+class LevelLoader;
+class SpriteAtlas;
+class SpriteBatch;
+
 class Level {
 public:
     Level();
     ~Level();
     
-    void loadTestLevel();
-    bool loadFromFile(int levelNumber);  // Load level from LEVELS.DAT
+    void loadTestLevel(uint32_t seed);  // Same seed, same level
+    bool loadFromFile(int levelNumber);  // Load level from the pack set below
+    void setLevelLoader(const LevelLoader* loader) { levelLoader = loader; }
     void clearAllObjects();  // Clear all objects except borders
     
     void update(float deltaTime);
     void render(SDL_Renderer* renderer);
-    void renderRegion(SDL_Renderer* renderer, int startX, int startY, int endX, int endY, float offsetX, float offsetY);
+    void renderRegion(SpriteBatch& batch, int startX, int startY, int endX, int endY, float offsetX, float offsetY, float alpha);
+    
+    // Redraw changed cells of the cached static-tile layer. Call before setting
+    // the level viewport, since it switches the render target.
+    void updateStaticLayer(SpriteBatch& batch);
+    // Forget the layer's contents after the renderer reset its targets; with
+    // textureLost (device reset) the texture itself is recreated too
+    void invalidateStaticLayer(bool textureLost);
+    
+    // Change tracking for the renderer: the revision is bumped by every change
+    // to what renderRegion draws, and a settled level (nothing awake, Murphy
+    // standing still) draws the same frame whatever the interpolation alpha.
+    uint64_t getRevision() const { return revision; }
+    bool isSettled() const;
     
     // Object management
     GameObject* getObjectAt(int x, int y) const;
     void removeObjectAt(int x, int y);
-    void addObject(std::unique_ptr<GameObject> object);
+    GameObject* createObject(ObjectType type, int x, int y);  // nullptr for unimplemented types
+    void reserveObjects(ObjectType type, size_t count);      // Pre-size a pool before a bulk load
     void moveObject(GameObject* obj, int newX, int newY);  // Add this for gravity
     
     // Digging
@@ -41,8 +61,19 @@ public:
     MurphyObject* getMurphy() const { return murphy; }
     void spawnMurphy(int x, int y);
     
-    // Gravity system
-    void triggerGravityCheckAbove(int x, int y);  // Moved to public section
+    // Input: Murphy polls this once per tick; no provider means no buttons held
+    void setInputProvider(InputProvider* provider) { inputProvider = provider; }
+    InputState pollInput() { return inputProvider ? inputProvider->poll() : InputState(); }
+    
+    size_t getObjectCount() const { return store.size(); }
+    const std::vector<GameObject*>& getObjects() const { return store.getObjects(); }
+    
+    // Snapshots: the full simulation state (objects, awake order, grid) as a
+    // flat byte buffer. Restoring rebuilds the level so that the next update()
+    // runs exactly as it would have from the saved tick.
+    void saveSnapshot(std::vector<uint8_t>& out) const;
+    bool restoreSnapshot(const uint8_t* data, size_t size);
+    bool restoreSnapshot(const std::vector<uint8_t>& data) { return restoreSnapshot(data.data(), data.size()); }
     
     static constexpr int LEVEL_WIDTH = 58;  // Changed from 60 to 58
     static constexpr int LEVEL_HEIGHT = 22; // Changed from 24 to 22
@@ -52,13 +83,98 @@ public:
     static constexpr int SPRITE_BORDER_CORNERS = 229;
     static constexpr int SPRITE_BORDER_VERTICAL = 230;
     static constexpr int SPRITE_BORDER_HORIZONTAL = 231;
-
+    
+    static constexpr uint32_t SNAPSHOT_MAGIC = 0x4E535053;  // "SPSN"
+    static constexpr uint8_t SNAPSHOT_VERSION = 4;
+    
 private:
-    std::vector<std::unique_ptr<GameObject>> objects;
+    using Slot = EntityStore::Slot;
+    
+    // State every object has (type, position, flags, sprite, animation) in
+    // packed arrays; a slot is the object's index in the live list. The
+    // objects themselves are owned by the per-type pools below.
+    EntityStore store;
+    ObjectPool<BaseObject> basePool;
+    ObjectPool<InfotronObject> infotronPool;
+    ObjectPool<ZonkObject> zonkPool;
+    ObjectPool<ChipObject> chipPool;
+    ObjectPool<MurphyObject> murphyPool;
+    
+    void addObject(GameObject* object);
+    void destroyObject(Slot slot);
     MurphyObject* murphy; // Direct pointer for quick access
-    BorderSprite borderSprite;
+    InputProvider* inputProvider;
+    const LevelLoader* levelLoader;
+    
+    // Active set: only objects in here get update() each frame. Objects join
+    // when dug/collected or when a neighbouring cell changes, and drop out
+    // again once they are idle.
+    std::vector<Slot> awakeSlots;
+    
+    void wakeObject(GameObject* obj);
+    
+    // Occupancy grid: the store slot of the non-player object in each cell.
+    // Murphy is kept out of the grid since he shares cells with the BASE or
+    // INFOTRON he is walking onto; getObjectAt falls back to him explicitly.
+    std::array<Slot, LEVEL_WIDTH * LEVEL_HEIGHT> grid;
+    
+    // Per-type bitboards mirroring the grid, one 64-bit mask per row, so
+    // walkability and gravity tests on whole rows are a few bitwise ops.
+    // Solid cells hold anything Murphy can't enter (zonks, chips).
+    using CellMask = BitGrid<LEVEL_WIDTH, LEVEL_HEIGHT>;
+    CellMask occupiedCells;
+    CellMask zonkCells;
+    CellMask infotronCells;
+    CellMask baseCells;
+    CellMask solidCells;
+    
+    static bool inBounds(int x, int y) { return x >= 0 && x < LEVEL_WIDTH && y >= 0 && y < LEVEL_HEIGHT; }
+    static int cellIndex(int x, int y) { return y * LEVEL_WIDTH + x; }
+    void placeInGrid(Slot slot);
+    void removeFromGrid(Slot slot);
+    void setCellMasks(int x, int y, Slot slot);
+    void clearCellMasks();
+    
+    // Gravity: one bottom-up sweep per tick moves every zonk. A moving zonk
+    // already sits in its destination cell; the cell it is leaving stays
+    // reserved until it arrives, so nothing else can enter it.
+    CellMask reserved;
+    CellMask movedThisPass;
+    CellMask movingZonkCells;
+    
+    void updateGravity(float deltaTime);
+    void tryStartZonkMove(ZonkObject* zonk);
+    bool isCellFree(int x, int y) const;
+    uint64_t getMurphyRow(int y) const;
+    uint64_t getFreeRow(int y) const;
+    uint64_t getGravityCandidates(int y) const;
+    
+    // Static-tile layer: the whole level plus borders pre-rendered into a target
+    // texture. Idle objects live in the layer; awake ones and Murphy are drawn on
+    // top each frame. Cells are redrawn only when marked dirty.
+    static constexpr int LAYER_WIDTH = (LEVEL_WIDTH + 2) * TILE_SIZE;
+    static constexpr int LAYER_HEIGHT = (LEVEL_HEIGHT + 2) * TILE_SIZE;
+    SDL_Texture* staticLayer;
+    bool staticLayerValid;
+    std::array<bool, LEVEL_WIDTH * LEVEL_HEIGHT> cellDirty;
+    std::vector<int> dirtyCells;
+    uint64_t revision;
+    
+    void markCellDirty(int x, int y);
+    
+    // What the static layer shows in a cell. restoreSnapshot compares these
+    // before and after, so a rewind only redraws the cells that changed.
+    struct StaticCell {
+        int spriteId;  // -1 when no idle object is drawn there
+        float x, y;
+    };
+    StaticCell getStaticCell(int index) const;
+    std::array<StaticCell, LEVEL_WIDTH * LEVEL_HEIGHT> cellsBeforeRestore;
+    void renderStaticCell(SpriteBatch& batch, const SpriteAtlas& atlas, int index);
+    void renderObject(SpriteBatch& batch, const SpriteAtlas& atlas, Slot slot, float offsetX, float offsetY, float alpha) const;
+    void renderDynamicObjects(SpriteBatch& batch, int startX, int startY, int endX, int endY, float offsetX, float offsetY, float alpha);
     
-    void renderBorders(SDL_Renderer* renderer, int startX, int startY, int endX, int endY, float offsetX, float offsetY);
+    void renderBorders(SpriteBatch& batch, int startX, int startY, int endX, int endY, float offsetX, float offsetY);
     void cleanupInactiveObjects();
 };
 
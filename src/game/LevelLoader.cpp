@@ -4,57 +4,92 @@
 #include "../entities/InfotronObject.hpp"
 #include "../entities/ZonkObject.hpp"
 #include "../entities/ChipObject.hpp"
-#include <fstream>
-#include <iostream>
+#include "../systems/Log.hpp"
 
-std::vector<LevelData> LevelLoader::levels;
-int LevelLoader::levelCount = 0;
+LevelLoader::LevelLoader() : packData(nullptr), levelCount(0), verbose(true) {
+}
 
 bool LevelLoader::loadLevelsFile(const std::string& filePath) {
-    std::ifstream file(filePath, std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open levels file: " << filePath << std::endl;
+    // Drop views into any previously mapped pack first
+    attachPack(nullptr, 0, filePath);
+    
+    if (!levelsFile.open(filePath)) {
+        LOG_ERROR("Failed to open levels file").field("path", filePath);
         return false;
     }
     
-    // Get file size
-    file.seekg(0, std::ios::end);
-    size_t fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
+    attachPack(levelsFile.data(), levelsFile.size(), filePath);
+    return true;
+}
+
+bool LevelLoader::loadLevelsData(const uint8_t* data, size_t size, const std::string& sourceName) {
+    attachPack(data, size, sourceName);
+    levelsFile.close();
+    return data != nullptr;
+}
+
+void LevelLoader::attachPack(const uint8_t* data, size_t size, const std::string& sourceName) {
+    packData = data;
+    levelCount = 0;
+    levels.clear();
+    parsedFlags.reset();
+    if (!data) {
+        return;
+    }
     
     // Calculate number of levels (1536 bytes each)
-    levelCount = fileSize / 1536;
-    std::cout << "Found " << levelCount << " levels in " << filePath << std::endl;
-    
-    // Read all level data
-    std::vector<uint8_t> fileData(fileSize);
-    file.read(reinterpret_cast<char*>(fileData.data()), fileSize);
-    file.close();
-    
-    // Parse each level
-    levels.clear();
-    levels.reserve(levelCount);
+    levelCount = static_cast<int>(size / LEVEL_RECORD_SIZE);
+    if (verbose) LOG_INFO("Found levels").field("count", levelCount).field("source", sourceName);
     
-    for (int i = 0; i < levelCount; i++) {
-        size_t offset = i * 1536;
-        LevelData levelData = parseLevelData(fileData, offset);
-        levels.push_back(levelData);
+    // Levels are parsed lazily in getLevelData
+    levels.resize(levelCount);
+    parsedFlags.reset(new std::once_flag[levelCount]);
+}
+
+const LevelData& LevelLoader::getLevelData(int levelNumber) const {
+    int index = levelNumber - 1;  // Convert to 0-based index
+    
+    // Two threads asking for the same unparsed level parse it once
+    std::call_once(parsedFlags[index], [this, index]() {
+        levels[index] = parseLevelData(packData + index * LEVEL_RECORD_SIZE);
+    });
+    return levels[index];
+}
+
+void LevelLoader::parseAll() const {
+    for (int levelNumber = 1; levelNumber <= levelCount; levelNumber++) {
+        getLevelData(levelNumber);
     }
-    
-    return true;
 }
 
-bool LevelLoader::loadLevel(Level* level, int levelNumber) {
+bool LevelLoader::loadLevel(Level* level, int levelNumber) const {
     if (levelNumber < 1 || levelNumber > levelCount) {
-        std::cerr << "Invalid level number: " << levelNumber << std::endl;
+        LOG_ERROR("Invalid level number").field("level", levelNumber);
         return false;
     }
     
-    const LevelData& levelData = levels[levelNumber - 1];  // Convert to 0-based index
+    const LevelData& levelData = getLevelData(levelNumber);
     
     // Clear existing objects
     level->clearAllObjects();
     
+    // Count objects per type so each pool is sized with one allocation
+    size_t typeCounts[static_cast<size_t>(ObjectType::PORT_3) + 1] = {};
+    for (int y = 1; y < 24; y++) {
+        for (int x = 1; x < 60; x++) {
+            ObjectType type;
+            if (tileToImplementedType(levelData.tileData[y * 60 + x], type)) {
+                typeCounts[static_cast<size_t>(type)]++;
+            }
+        }
+    }
+    for (size_t i = 0; i <= static_cast<size_t>(ObjectType::PORT_3); i++) {
+        if (typeCounts[i] > 0) {
+            level->reserveObjects(static_cast<ObjectType>(i), typeCounts[i]);
+        }
+    }
+    level->reserveObjects(ObjectType::PLAYER, 1);
+    
     // Create objects from tile data
     int murphyX = -1, murphyY = -1;
     
@@ -65,8 +100,8 @@ bool LevelLoader::loadLevel(Level* level, int levelNumber) {
             uint8_t tileValue = levelData.tileData[index];
             
             // Debug: Log first few tiles to see what we're reading
-            if (x < 11 && y < 4) {  // Adjust debug range for shifted coordinates
-                std::cout << "Tile at (" << x << "," << y << "): 0x" << std::hex << (int)tileValue << std::dec << std::endl;
+            if (verbose && x < 11 && y < 4) {  // Adjust debug range for shifted coordinates
+                LOG_DEBUG("Tile").field("x", x).field("y", y).hexField("value", tileValue);
             }
             
             // Handle Murphy separately since he needs special spawning
@@ -77,52 +112,45 @@ bool LevelLoader::loadLevel(Level* level, int levelNumber) {
             }
             
             // Create appropriate game object at shifted position
-            auto object = createObjectFromTile(tileValue, x - 1, y - 1);  // Shift both X and Y positions
-            if (object) {
-                level->addObject(std::move(object));
-            }
+            createObjectFromTile(level, tileValue, x - 1, y - 1);  // Shift both X and Y positions
         }
     }
     
     // Spawn Murphy at the found position
     if (murphyX >= 0 && murphyY >= 0) {
-        std::cout << "Spawning Murphy at position (" << murphyX << ", " << murphyY << ")" << std::endl;
+        if (verbose) LOG_DEBUG("Spawning Murphy").field("x", murphyX).field("y", murphyY);
         level->spawnMurphy(murphyX, murphyY);
     } else {
-        std::cerr << "Warning: No Murphy starting position found in level " << levelNumber << std::endl;
-        std::cout << "Using fallback Murphy position (5, 10)" << std::endl;
+        LOG_WARN("No Murphy starting position found, using fallback (5, 10)").field("level", levelNumber);
         level->spawnMurphy(5, 10);  // Fallback position
     }
     
-    std::cout << "Loaded level " << levelNumber << ": \"" << levelData.title << "\"" << std::endl;
+    if (verbose) LOG_INFO("Loaded level").field("level", levelNumber).field("title", levelData.title);
     return true;
 }
 
-std::string LevelLoader::getLevelTitle(int levelNumber) {
+std::string LevelLoader::getLevelTitle(int levelNumber) const {
     if (levelNumber < 1 || levelNumber > levelCount) {
         return "Invalid Level";
     }
-    return levels[levelNumber - 1].title;
+    return getLevelData(levelNumber).title;
 }
 
-LevelData LevelLoader::parseLevelData(const std::vector<uint8_t>& rawData, size_t offset) {
+LevelData LevelLoader::parseLevelData(const uint8_t* record) {
     LevelData data;
     
-    // Extract tile data (first 1440 bytes = 60x24)
-    data.tileData.resize(1440);
-    for (int i = 0; i < 1440; i++) {
-        data.tileData[i] = rawData[offset + i];
-    }
+    // Tile data is the first 1440 bytes (60x24), used in place
+    data.tileData = record;
     
     // Extract level properties
-    data.gravity = (rawData[offset + 1444] != 0);
-    data.freezeZonks = (rawData[offset + 1469] != 0);
-    data.infrotronsNeeded = rawData[offset + 1470];
+    data.gravity = (record[1444] != 0);
+    data.freezeZonks = (record[1469] != 0);
+    data.infrotronsNeeded = record[1470];
     
     // Extract title (23 characters, space-padded)
     data.title.clear();
     for (int i = 0; i < 23; i++) {
-        char c = rawData[offset + 1446 + i];
+        char c = record[1446 + i];
         if (c != ' ') {  // Skip trailing spaces
             data.title += c;
         } else if (!data.title.empty()) {
@@ -130,6 +158,17 @@ LevelData LevelLoader::parseLevelData(const std::vector<uint8_t>& rawData, size_
         }
     }
     
+    // Special port table: 6 bytes per port, big-endian position first
+    data.specialPortCount = record[1471];
+    for (int i = 0; i < LevelData::MAX_SPECIAL_PORTS; i++) {
+        const uint8_t* entry = record + 1472 + i * 6;
+        SpecialPort& port = data.specialPorts[i];
+        port.position = static_cast<uint16_t>((entry[0] << 8) | entry[1]);
+        port.gravity = entry[2] != 0;
+        port.freezeZonks = entry[3] != 0;
+        port.freezeEnemies = entry[4] != 0;
+    }
+    
     return data;
 }
 
@@ -153,25 +192,37 @@ ObjectType LevelLoader::tileToObjectType(uint8_t tileValue) {
     }
 }
 
-std::unique_ptr<GameObject> LevelLoader::createObjectFromTile(uint8_t tileValue, int x, int y) {
+bool LevelLoader::tileToImplementedType(uint8_t tileValue, ObjectType& type) {
     switch (tileValue) {
         case 0x00:  // Empty - no object
-            return nullptr;
+            return false;
         case 0x01:  // Zonk
-            return std::make_unique<ZonkObject>(x, y);
+            type = ObjectType::ZONK;
+            return true;
         case 0x02:  // Base  
-            return std::make_unique<BaseObject>(x, y);
+            type = ObjectType::BASE;
+            return true;
         
         case 0x04:  // Infotron
-            return std::make_unique<InfotronObject>(x, y);
+            type = ObjectType::INFOTRON;
+            return true;
         case 0x05:  // RAM chip - now implemented
-            return std::make_unique<ChipObject>(x, y);
+            type = ObjectType::CHIP_1;
+            return true;
         case 0x06:  // Wall - not implemented yet
-            return nullptr;
+            return false;
         case 0x07:  // Exit - not implemented yet
-            return nullptr;
+            return false;
         // Add more cases as objects are implemented
         default:
-            return nullptr;  // Don't create any object for unimplemented tiles
+            return false;  // Don't create any object for unimplemented tiles
+    }
+}
+
+GameObject* LevelLoader::createObjectFromTile(Level* level, uint8_t tileValue, int x, int y) {
+    ObjectType type;
+    if (!tileToImplementedType(tileValue, type)) {
+        return nullptr;
     }
+    return level->createObject(type, x, y);
 }
@@ -3,35 +3,74 @@
 
 #include "../main.hpp"
 #include "../entities/GameObject.hpp"  // Add this include for ObjectType
+#include "../systems/MappedFile.hpp"
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 class Level;
 
+// Port tile that switches gravity/freeze flags as Murphy passes through it
+struct SpecialPort {
+    uint16_t position;  // Tile index * 2, as stored
+    bool gravity;
+    bool freezeZonks;
+    bool freezeEnemies;
+};
+
 struct LevelData {
-    std::vector<uint8_t> tileData;  // 60x24 tile array
+    static constexpr int MAX_SPECIAL_PORTS = 10;
+    
+    const uint8_t* tileData = nullptr;  // 60x24 tile array, viewed in place in the mapped file
     bool gravity;
     std::string title;
     bool freezeZonks;
-    uint8_t infrotronsNeeded;
+    uint8_t infrotronsNeeded;  // 0 means every infotron in the level
     int murphyStartX, murphyStartY;
+    uint8_t specialPortCount;  // As stored; only the first MAX_SPECIAL_PORTS are read
+    SpecialPort specialPorts[MAX_SPECIAL_PORTS];
 };
 
+// One loaded level pack. Levels are parsed on first access; after
+// loadLevelsFile() returns, every const method is safe to call from several
+// threads at once, so workers can share a loader.
 class LevelLoader {
 public:
-    static bool loadLevelsFile(const std::string& filePath);
-    static bool loadLevel(Level* level, int levelNumber);  // 1-based level number
-    static int getLevelCount() { return levelCount; }
-    static std::string getLevelTitle(int levelNumber);
+    LevelLoader();
+    
+    bool loadLevelsFile(const std::string& filePath);
+    // Uses a pack already in memory (e.g. an asset bundle mapping); the caller
+    // keeps it alive for as long as the loader is used
+    bool loadLevelsData(const uint8_t* data, size_t size, const std::string& sourceName);
+    bool loadLevel(Level* level, int levelNumber) const;  // 1-based level number
+    int getLevelCount() const { return levelCount; }
+    std::string getLevelTitle(int levelNumber) const;
+    void parseAll() const;  // Parse every level now instead of on first access
+    const LevelData& getLevelData(int levelNumber) const;  // 1-based; callers check the range
+    
+    // Per-load logging (pack size, tile dump, spawn position); off for batch tools
+    void setVerbose(bool enabled) { verbose = enabled; }
+    
+    static constexpr size_t LEVEL_RECORD_SIZE = 1536;
+    static constexpr size_t LEVEL_TILE_COUNT = 1440;
+    
+    // Decodes one LEVEL_RECORD_SIZE record; tiles are viewed in place
+    static LevelData parseLevelData(const uint8_t* record);
+    // Object type the loader creates for a tile; false for tiles it drops
+    static bool tileToImplementedType(uint8_t tileValue, ObjectType& type);
     
 private:
-    static std::vector<LevelData> levels;
-    static int levelCount;
+    MappedFile levelsFile;
+    const uint8_t* packData;  // levelsFile or caller-owned memory
+    mutable std::vector<LevelData> levels;  // Parsed on first access
+    mutable std::unique_ptr<std::once_flag[]> parsedFlags;  // One per level
+    int levelCount;
+    bool verbose;
     
+    void attachPack(const uint8_t* data, size_t size, const std::string& sourceName);
     static ObjectType tileToObjectType(uint8_t tileValue);
-    static std::unique_ptr<GameObject> createObjectFromTile(uint8_t tileValue, int x, int y);
-    static LevelData parseLevelData(const std::vector<uint8_t>& rawData, size_t offset);
+    static GameObject* createObjectFromTile(Level* level, uint8_t tileValue, int x, int y);
 };
 
 #endif // LEVELLOADER_HPP
@@ -0,0 +1,223 @@
+// Level's drawing code: the cached static-tile layer, moving objects and the
+// borders. Lives in the render library so the simulation core never touches
+// the sprite atlas or a renderer.
+#include "Level.hpp"
+#include "../systems/AssetManager.hpp"
+#include "../systems/BorderSprite.hpp"
+#include "../systems/Log.hpp"
+#include "../systems/Profiler.hpp"
+#include "../systems/SpriteBatch.hpp"
+
+void Level::invalidateStaticLayer(bool textureLost) {
+    if (textureLost && staticLayer) {
+        SDL_DestroyTexture(staticLayer);
+        staticLayer = nullptr;
+    }
+    staticLayerValid = false;
+}
+
+void Level::updateStaticLayer(SpriteBatch& batch) {
+    SDL_Renderer* renderer = batch.getRenderer();
+    if (!renderer) return;
+    
+    if (!staticLayer) {
+        if (!SDL_RenderTargetSupported(renderer)) return;
+        
+        staticLayer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                        LAYER_WIDTH, LAYER_HEIGHT);
+        if (!staticLayer) {
+            LOG_WARN("Could not create static tile layer, drawing tiles directly").field("error", SDL_GetError());
+            return;
+        }
+        staticLayerValid = false;
+    }
+    
+    if (staticLayerValid && dirtyCells.empty()) return;
+    
+    // Counted as region drawing, so the borders drawn here nest like the
+    // ones renderRegion draws
+    PROFILE_SCOPE(RENDER_REGION);
+    
+    // Finish anything already queued for the current target
+    batch.flush();
+    
+    const SpriteAtlas& atlas = AssetManager::getInstance().getSpriteAtlas();
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, staticLayer);
+    SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
+    
+    if (!staticLayerValid) {
+        // Full rebuild: borders plus every idle object
+        SDL_RenderClear(renderer);
+        renderBorders(batch, -1, -1, LEVEL_WIDTH + 1, LEVEL_HEIGHT + 1, TILE_SIZE, TILE_SIZE);
+        for (int index = 0; index < LEVEL_WIDTH * LEVEL_HEIGHT; index++) {
+            renderStaticCell(batch, atlas, index);
+        }
+        staticLayerValid = true;
+    } else {
+        // Clear the changed cells first, then draw all of them in one batch
+        for (int index : dirtyCells) {
+            SDL_Rect cellRect = {(index % LEVEL_WIDTH + 1) * TILE_SIZE, (index / LEVEL_WIDTH + 1) * TILE_SIZE,
+                                 TILE_SIZE, TILE_SIZE};
+            SDL_RenderFillRect(renderer, &cellRect);
+        }
+        for (int index : dirtyCells) {
+            renderStaticCell(batch, atlas, index);
+        }
+    }
+    
+    batch.flush();
+    SDL_SetRenderTarget(renderer, previousTarget);
+    
+    for (int index : dirtyCells) {
+        cellDirty[index] = false;
+    }
+    dirtyCells.clear();
+}
+
+void Level::renderStaticCell(SpriteBatch& batch, const SpriteAtlas& atlas, int index) {
+    Slot slot = grid[index];
+    if (slot != EntityStore::NO_SLOT && (store.getFlags(slot) & (EntityStore::ACTIVE | EntityStore::AWAKE)) == EntityStore::ACTIVE) {
+        // The layer's origin is the top-left border cell
+        renderObject(batch, atlas, slot, TILE_SIZE, TILE_SIZE, 1.0f);
+    }
+}
+
+void Level::renderObject(SpriteBatch& batch, const SpriteAtlas& atlas, Slot slot, float offsetX, float offsetY, float alpha) const {
+    int spriteId = store.getSpriteId(slot);
+    if (!atlas.isValid(spriteId)) return;
+    
+    // Interpolate between ticks, but keep positioning pixel-perfect
+    int pixelX = static_cast<int>(roundf((store.getRenderX(slot, alpha) * TILE_SIZE) + offsetX));
+    int pixelY = static_cast<int>(roundf((store.getRenderY(slot, alpha) * TILE_SIZE) + offsetY));
+    SDL_Rect dstRect = {pixelX, pixelY, SpriteAtlas::SPRITE_SIZE, SpriteAtlas::SPRITE_SIZE};
+    batch.draw(atlas.getTexture(), atlas.getSpriteRect(spriteId), dstRect);
+}
+
+void Level::renderRegion(SpriteBatch& batch, int startX, int startY, int endX, int endY, float offsetX, float offsetY, float alpha) {
+    PROFILE_SCOPE(RENDER_REGION);
+    
+    if (staticLayer && staticLayerValid) {
+        // One blit for borders and idle tiles, then whatever is moving
+        SDL_Rect srcRect = {0, 0, LAYER_WIDTH, LAYER_HEIGHT};
+        SDL_Rect dstRect = {static_cast<int>(offsetX) - TILE_SIZE, static_cast<int>(offsetY) - TILE_SIZE,
+                            LAYER_WIDTH, LAYER_HEIGHT};
+        batch.draw(staticLayer, srcRect, dstRect);
+        renderDynamicObjects(batch, startX, startY, endX, endY, offsetX, offsetY, alpha);
+        return;
+    }
+    
+    // Render borders first
+    renderBorders(batch, startX, startY, endX, endY, offsetX, offsetY);
+    
+    // Then render level tiles
+    const SpriteAtlas& atlas = AssetManager::getInstance().getSpriteAtlas();
+    for (int y = startY; y < endY; y++) {
+        for (int x = startX; x < endX; x++) {
+            // Only render tiles within the actual level bounds (58x22)
+            if (x < 0 || x >= LEVEL_WIDTH || y < 0 || y >= LEVEL_HEIGHT) {
+                continue;
+            }
+            
+            Slot slot = grid[cellIndex(x, y)];
+            if (slot != EntityStore::NO_SLOT && store.hasFlag(slot, EntityStore::ACTIVE)) {
+                renderObject(batch, atlas, slot, offsetX, offsetY, alpha);
+            }
+        }
+    }
+    
+    // Murphy isn't in the grid
+    if (murphy && murphy->isActive()) {
+        int murphyX = murphy->getX();
+        int murphyY = murphy->getY();
+        
+        // Always render Murphy if he's in the visible region
+        if (murphyX >= startX && murphyX < endX && murphyY >= startY && murphyY < endY) {
+            renderObject(batch, atlas, murphy->getSlot(), offsetX, offsetY, alpha);
+        }
+    }
+}
+
+void Level::renderDynamicObjects(SpriteBatch& batch, int startX, int startY, int endX, int endY, float offsetX, float offsetY, float alpha) {
+    const SpriteAtlas& atlas = AssetManager::getInstance().getSpriteAtlas();
+    Slot murphySlot = murphy ? murphy->getSlot() : EntityStore::NO_SLOT;
+    for (Slot slot : awakeSlots) {
+        if (!store.hasFlag(slot, EntityStore::ACTIVE) || slot == murphySlot) continue;
+        
+        int x = store.getX(slot);
+        int y = store.getY(slot);
+        if (x >= startX && x < endX && y >= startY && y < endY) {
+            renderObject(batch, atlas, slot, offsetX, offsetY, alpha);
+        }
+    }
+    
+    // Murphy always goes on top
+    if (murphy && murphy->isActive()) {
+        int murphyX = murphy->getX();
+        int murphyY = murphy->getY();
+        if (murphyX >= startX && murphyX < endX && murphyY >= startY && murphyY < endY) {
+            renderObject(batch, atlas, murphySlot, offsetX, offsetY, alpha);
+        }
+    }
+}
+
+void Level::renderBorders(SpriteBatch& batch, int startX, int startY, int endX, int endY, float offsetX, float offsetY) {
+    PROFILE_SCOPE(RENDER_BORDERS);
+    
+    BorderSprite border(&AssetManager::getInstance().getSpriteAtlas(), SPRITE_BORDER_CORNERS);
+    
+    // Render borders for positions outside the 58x22 level area
+    for (int y = startY; y < endY; y++) {
+        for (int x = startX; x < endX; x++) {
+            // Only render borders outside the level bounds
+            bool isLeftBorder = (x == -1);
+            bool isRightBorder = (x == LEVEL_WIDTH);
+            bool isTopBorder = (y == -1);
+            bool isBottomBorder = (y == LEVEL_HEIGHT);
+            
+            // Skip if this is inside the level and not a border
+            if (!isLeftBorder && !isRightBorder && !isTopBorder && !isBottomBorder) {
+                continue;
+            }
+            
+            int spriteId;
+            int quarter;
+            bool shouldRender = true;
+            
+            // Determine border type and quarter based on position
+            if (isLeftBorder && isTopBorder) {
+                spriteId = SPRITE_BORDER_CORNERS;
+                quarter = 0;
+            } else if (isRightBorder && isTopBorder) {
+                spriteId = SPRITE_BORDER_CORNERS;
+                quarter = 1;
+            } else if (isLeftBorder && isBottomBorder) {
+                spriteId = SPRITE_BORDER_CORNERS;
+                quarter = 2;
+            } else if (isRightBorder && isBottomBorder) {
+                spriteId = SPRITE_BORDER_CORNERS;
+                quarter = 3;
+            } else if (isTopBorder) {
+                spriteId = SPRITE_BORDER_HORIZONTAL;
+                quarter = 2;
+            } else if (isBottomBorder) {
+                spriteId = SPRITE_BORDER_HORIZONTAL;
+                quarter = 0;
+            } else if (isLeftBorder) {
+                spriteId = SPRITE_BORDER_VERTICAL;
+                quarter = 0;
+            } else if (isRightBorder) {
+                spriteId = SPRITE_BORDER_VERTICAL;
+                quarter = 1;
+            } else {
+                shouldRender = false;
+            }
+            
+            if (shouldRender) {
+                int renderX = static_cast<int>((x * TILE_SIZE) + offsetX);
+                int renderY = static_cast<int>((y * TILE_SIZE) + offsetY);
+                border.renderWithSprite(batch, renderX, renderY, spriteId, quarter);
+            }
+        }
+    }
+}
@@ -0,0 +1,312 @@
+#include "LevelSolver.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+const int LevelSolver::DIRECTION_DX[DIRECTION_COUNT] = {1, 0, -1, 0};
+const int LevelSolver::DIRECTION_DY[DIRECTION_COUNT] = {0, 1, 0, -1};
+
+namespace {
+
+const uint8_t PORT_RIGHT = 1;
+const uint8_t PORT_DOWN = 2;
+const uint8_t PORT_LEFT = 4;
+const uint8_t PORT_UP = 8;
+
+}
+
+LevelSolver::LevelSolver() {
+    reset();
+}
+
+void LevelSolver::reset() {
+    walkable.clear();
+    infotrons.clear();
+    reachable.clear();
+    start = NO_CELL;
+    exit = NO_CELL;
+    infotronsNeeded = 0;
+    portDirections.fill(0);
+    portCount = 0;
+}
+
+uint8_t LevelSolver::tilePortDirections(uint8_t tileValue) {
+    switch (tileValue) {
+        case 0x09: case 0x0D: return PORT_RIGHT;
+        case 0x0A: case 0x0E: return PORT_DOWN;
+        case 0x0B: case 0x0F: return PORT_LEFT;
+        case 0x0C: case 0x10: return PORT_UP;
+        case 0x15: return PORT_UP | PORT_DOWN;
+        case 0x16: return PORT_LEFT | PORT_RIGHT;
+        case 0x17: return PORT_LEFT | PORT_RIGHT | PORT_UP | PORT_DOWN;
+        default: return 0;
+    }
+}
+
+void LevelSolver::load(const LevelData& data) {
+    reset();
+    infotronsNeeded = data.infrotronsNeeded;
+    
+    // The pack's 60x24 tiles include the hardware border; the field is the inner 58x22
+    for (int y = 0; y < Level::LEVEL_HEIGHT; y++) {
+        for (int x = 0; x < Level::LEVEL_WIDTH; x++) {
+            uint8_t tileValue = data.tileData[(y + 1) * 60 + (x + 1)];
+            switch (tileValue) {
+                case 0x03:  // Murphy
+                    start = cellAt(x, y);
+                    walkable.set(x, y);
+                    break;
+                case 0x04:  // Infotron
+                    infotrons.set(x, y);
+                    walkable.set(x, y);
+                    break;
+                case 0x00:  // Empty
+                case 0x02:  // Base
+                case 0x11:  // Snik snak and electron start on empty cells
+                case 0x18:
+                case 0x19:  // Bug: a base that sparks
+                    walkable.set(x, y);
+                    break;
+                case 0x07:
+                    exit = cellAt(x, y);
+                    break;
+                default:
+                    if (uint8_t directions = tilePortDirections(tileValue)) {
+                        portDirections[cellAt(x, y)] = directions;
+                        ports[portCount++] = cellAt(x, y);
+                    }
+                    break;
+            }
+        }
+    }
+}
+
+void LevelSolver::load(const Level& level) {
+    reset();
+    
+    for (int y = 0; y < Level::LEVEL_HEIGHT; y++) {
+        for (int x = 0; x < Level::LEVEL_WIDTH; x++) {
+            if (level.isWalkable(x, y)) {
+                walkable.set(x, y);
+            }
+            const GameObject* obj = level.getObjectAt(x, y);
+            if (obj && obj->getType() == ObjectType::INFOTRON) {
+                infotrons.set(x, y);
+            }
+        }
+    }
+    
+    const MurphyObject* murphy = level.getMurphy();
+    if (murphy && murphy->isActive()) {
+        start = cellAt(murphy->getX(), murphy->getY());
+        walkable.set(murphy->getX(), murphy->getY());
+    }
+}
+
+template<typename Visit>
+void LevelSolver::forEachMove(Cell cell, Visit visit) const {
+    int x = cellX(cell);
+    int y = cellY(cell);
+    for (int direction = 0; direction < DIRECTION_COUNT; direction++) {
+        int nx = x + DIRECTION_DX[direction];
+        int ny = y + DIRECTION_DY[direction];
+        if (nx < 0 || nx >= Level::LEVEL_WIDTH || ny < 0 || ny >= Level::LEVEL_HEIGHT) continue;
+        
+        Cell next = cellAt(nx, ny);
+        if (walkable.test(nx, ny) || next == exit) {
+            visit(next);
+        } else if (portDirections[next] & (1 << direction)) {
+            // Straight through the port to the cell beyond
+            int px = nx + DIRECTION_DX[direction];
+            int py = ny + DIRECTION_DY[direction];
+            if (px >= 0 && px < Level::LEVEL_WIDTH && py >= 0 && py < Level::LEVEL_HEIGHT && walkable.test(px, py)) {
+                visit(cellAt(px, py));
+            }
+        }
+    }
+}
+
+const LevelSolver::Grid& LevelSolver::computeReachable() {
+    reachable.clear();
+    if (start == NO_CELL) {
+        return reachable;
+    }
+    reachable.set(cellX(start), cellY(start));
+    
+    // Walking into the exit ends the level, so nothing spreads out of it
+    auto exitMask = [this](int y) -> uint64_t {
+        return exit != NO_CELL && cellY(exit) == y ? uint64_t(1) << cellX(exit) : 0;
+    };
+    auto growRow = [&](int y) {
+        uint64_t enterable = walkable.getRow(y) | exitMask(y);
+        uint64_t row = reachable.getRow(y);
+        uint64_t next = row;
+        if (y > 0) next |= reachable.getRow(y - 1) & ~exitMask(y - 1) & enterable;
+        if (y + 1 < Level::LEVEL_HEIGHT) next |= reachable.getRow(y + 1) & ~exitMask(y + 1) & enterable;
+        
+        // Fill horizontal runs within the row
+        uint64_t previous;
+        do {
+            previous = next;
+            uint64_t sources = next & ~exitMask(y);
+            next |= ((sources << 1) | (sources >> 1)) & enterable;
+        } while (next != previous);
+        
+        reachable.setRow(y, next);
+        return next != row;
+    };
+    
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        
+        // Sweep down then up, so spreading in either direction takes one pass
+        for (int y = 0; y < Level::LEVEL_HEIGHT; y++) {
+            changed |= growRow(y);
+        }
+        for (int y = Level::LEVEL_HEIGHT - 1; y >= 0; y--) {
+            changed |= growRow(y);
+        }
+        
+        for (int i = 0; i < portCount; i++) {
+            Cell port = ports[i];
+            for (int direction = 0; direction < DIRECTION_COUNT; direction++) {
+                if (!(portDirections[port] & (1 << direction))) continue;
+                
+                int fromX = cellX(port) - DIRECTION_DX[direction];
+                int fromY = cellY(port) - DIRECTION_DY[direction];
+                int toX = cellX(port) + DIRECTION_DX[direction];
+                int toY = cellY(port) + DIRECTION_DY[direction];
+                if (fromX < 0 || fromX >= Level::LEVEL_WIDTH || fromY < 0 || fromY >= Level::LEVEL_HEIGHT ||
+                    toX < 0 || toX >= Level::LEVEL_WIDTH || toY < 0 || toY >= Level::LEVEL_HEIGHT) {
+                    continue;
+                }
+                if (reachable.test(fromX, fromY) && cellAt(fromX, fromY) != exit &&
+                    walkable.test(toX, toY) && !reachable.test(toX, toY)) {
+                    reachable.set(toX, toY);
+                    changed = true;
+                }
+            }
+        }
+    }
+    return reachable;
+}
+
+void LevelSolver::computeDistances(Cell from) {
+    distance.fill(UNREACHABLE);
+    if (from == NO_CELL) return;
+    
+    int head = 0;
+    int tail = 0;
+    distance[from] = 0;
+    queue[tail++] = from;
+    while (head < tail) {
+        Cell cell = queue[head++];
+        if (cell == exit && cell != from) continue;
+        
+        uint16_t nextDistance = distance[cell] + 1;
+        forEachMove(cell, [&](Cell next) {
+            if (distance[next] == UNREACHABLE) {
+                distance[next] = nextDistance;
+                queue[tail++] = next;
+            }
+        });
+    }
+}
+
+LevelSolver::Cell LevelSolver::nearestIn(const Grid& targets) const {
+    Cell nearest = NO_CELL;
+    for (int y = 0; y < Level::LEVEL_HEIGHT; y++) {
+        for (uint64_t bits = targets.getRow(y); bits; bits &= bits - 1) {
+            Cell cell = cellAt(Grid::lowestBit(bits), y);
+            if (distance[cell] != UNREACHABLE && (nearest == NO_CELL || distance[cell] < distance[nearest])) {
+                nearest = cell;
+            }
+        }
+    }
+    return nearest;
+}
+
+LevelSolver::Cell LevelSolver::findNearestInfotron(Cell from) {
+    computeDistances(from);
+    return nearestIn(infotrons);
+}
+
+int LevelSolver::heuristic(Cell from, Cell to) const {
+    int manhattan = std::abs(cellX(from) - cellX(to)) + std::abs(cellY(from) - cellY(to));
+    // A port crossing covers two cells in one move
+    return portCount > 0 ? manhattan / 2 : manhattan;
+}
+
+bool LevelSolver::findPath(Cell from, Cell to, std::vector<Cell>& path) {
+    path.clear();
+    if (from == NO_CELL || to == NO_CELL) return false;
+    
+    pathCost.fill(UNREACHABLE);
+    pathCost[from] = 0;
+    size_t heapSize = 0;
+    heap[heapSize++] = (static_cast<uint32_t>(heuristic(from, to)) << 16) | from;
+    
+    while (heapSize > 0) {
+        std::pop_heap(heap.begin(), heap.begin() + heapSize, std::greater<uint32_t>());
+        uint32_t entry = heap[--heapSize];
+        Cell cell = static_cast<Cell>(entry & 0xFFFF);
+        
+        // Skip entries superseded by a cheaper route
+        if ((entry >> 16) != static_cast<uint32_t>(pathCost[cell] + heuristic(cell, to))) continue;
+        
+        if (cell == to) {
+            for (Cell step = to; step != from; step = cameFrom[step]) {
+                path.push_back(step);
+            }
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+        if (cell == exit && cell != from) continue;
+        
+        uint16_t nextCost = pathCost[cell] + 1;
+        forEachMove(cell, [&](Cell next) {
+            if (nextCost < pathCost[next]) {
+                pathCost[next] = nextCost;
+                cameFrom[next] = cell;
+                heap[heapSize++] = (static_cast<uint32_t>(nextCost + heuristic(next, to)) << 16) | next;
+                std::push_heap(heap.begin(), heap.begin() + heapSize, std::greater<uint32_t>());
+            }
+        });
+    }
+    return false;
+}
+
+void LevelSolver::planCollection(Plan& plan) {
+    plan.order.clear();
+    plan.steps = 0;
+    plan.exitSteps = -1;
+    
+    computeReachable();
+    Grid remaining;
+    for (int y = 0; y < Level::LEVEL_HEIGHT; y++) {
+        remaining.setRow(y, infotrons.getRow(y) & reachable.getRow(y));
+    }
+    plan.unreachableInfotrons = infotrons.count() - remaining.count();
+    
+    Cell position = start;
+    while (position != NO_CELL) {
+        computeDistances(position);
+        Cell nearest = nearestIn(remaining);
+        if (nearest == NO_CELL) {
+            break;
+        }
+        
+        plan.order.push_back(nearest);
+        plan.steps += distance[nearest];
+        remaining.reset(cellX(nearest), cellY(nearest));
+        position = nearest;
+    }
+    // Infotrons that are reachable from the start but not after a one-way port
+    plan.unreachableInfotrons += remaining.count();
+    
+    // The loop always ends on a search from the final position
+    if (exit != NO_CELL && position != NO_CELL && distance[exit] != UNREACHABLE) {
+        plan.exitSteps = distance[exit];
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef LEVELSOLVER_HPP
+#define LEVELSOLVER_HPP
+
+#include "../main.hpp"
+#include "BitGrid.hpp"
+#include "Level.hpp"
+#include "LevelLoader.hpp"
+#include <array>
+#include <vector>
+
+// Reachability and path planning for Murphy over a still picture of the
+// field, taken from a pack's raw tiles or from a live Level. Empty cells,
+// bases and infotrons are walkable (digging and collecting take one step like
+// walking), ports let Murphy through in their directions (one step per
+// crossing), and everything else is solid. Falling zonks, pushing and enemies
+// are ignored, so plans are approximate.
+//
+// All search state lives in the solver and queries don't allocate, so keep
+// one solver per thread and reuse it.
+class LevelSolver {
+public:
+    using Grid = BitGrid<Level::LEVEL_WIDTH, Level::LEVEL_HEIGHT>;
+    using Cell = uint16_t;  // y * LEVEL_WIDTH + x
+    
+    static constexpr int CELL_COUNT = Level::LEVEL_WIDTH * Level::LEVEL_HEIGHT;
+    static constexpr Cell NO_CELL = 0xFFFF;
+    static constexpr uint16_t UNREACHABLE = 0xFFFF;
+    
+    struct Plan {
+        std::vector<Cell> order;  // Infotrons in collection order
+        int steps = 0;            // To collect all of them
+        int exitSteps = -1;       // From the last infotron to the exit; -1 when there's no way
+        int unreachableInfotrons = 0;
+    };
+    
+    LevelSolver();
+    
+    void load(const LevelData& data);
+    void load(const Level& level);  // Murphy's current cell is the start; no ports or exit yet
+    
+    Cell getStart() const { return start; }
+    Cell getExit() const { return exit; }
+    int getInfotronsNeeded() const { return infotronsNeeded; }  // 0 means all of them
+    const Grid& getInfotrons() const { return infotrons; }
+    
+    // Cells Murphy can get to from the start, by a bitwise flood fill
+    const Grid& computeReachable();
+    
+    // Breadth-first step counts from `from` to every cell (UNREACHABLE where
+    // there's no way), read back with getDistance
+    void computeDistances(Cell from);
+    uint16_t getDistance(Cell cell) const { return distance[cell]; }
+    
+    // Closest infotron by walking distance (recomputes the distances), or NO_CELL
+    Cell findNearestInfotron(Cell from);
+    
+    // A* shortest path; `path` gets every cell after `from` up to and including `to`
+    bool findPath(Cell from, Cell to, std::vector<Cell>& path);
+    
+    // Greedy nearest-first order over the reachable infotrons, then the exit
+    void planCollection(Plan& plan);
+    
+    static Cell cellAt(int x, int y) { return static_cast<Cell>(y * Level::LEVEL_WIDTH + x); }
+    static int cellX(Cell cell) { return cell % Level::LEVEL_WIDTH; }
+    static int cellY(Cell cell) { return cell / Level::LEVEL_WIDTH; }
+    
+private:
+    // Directions as bits of portDirections: right, down, left, up
+    static constexpr int DIRECTION_COUNT = 4;
+    static const int DIRECTION_DX[DIRECTION_COUNT];
+    static const int DIRECTION_DY[DIRECTION_COUNT];
+    
+    static uint8_t tilePortDirections(uint8_t tileValue);
+    void reset();
+    
+    // Calls visit(neighbour) for every cell one move away from `cell`
+    template<typename Visit>
+    void forEachMove(Cell cell, Visit visit) const;
+    
+    int heuristic(Cell from, Cell to) const;
+    Cell nearestIn(const Grid& targets) const;  // By the current distances
+    
+    Grid walkable;   // Cells Murphy can stand in
+    Grid infotrons;
+    Grid reachable;
+    Cell start;
+    Cell exit;       // Can be entered but not left
+    int infotronsNeeded;
+    
+    std::array<uint8_t, CELL_COUNT> portDirections;  // 0 for cells that aren't ports
+    std::array<Cell, CELL_COUNT> ports;
+    int portCount;
+    
+    // Search scratch
+    std::array<uint16_t, CELL_COUNT> distance;
+    std::array<Cell, CELL_COUNT> queue;
+    std::array<uint16_t, CELL_COUNT> pathCost;
+    std::array<Cell, CELL_COUNT> cameFrom;
+    std::array<uint32_t, CELL_COUNT * DIRECTION_COUNT> heap;  // (estimate << 16) | cell
+};
+
+#endif // LEVELSOLVER_HPP
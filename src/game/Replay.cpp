@@ -0,0 +1,196 @@
+#include "Replay.hpp"
+#include "Level.hpp"
+#include "../systems/Log.hpp"
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+const char REPLAY_MAGIC[4] = {'S', 'P', 'R', 'C'};
+const uint8_t REPLAY_VERSION = 1;
+// A day at the original 35 Hz. The tick count comes from the file, so it's
+// capped before it sizes anything.
+const uint32_t MAX_REPLAY_TICKS = 35 * 60 * 60 * 24;
+
+void writeU8(std::ostream& out, uint8_t value) {
+    out.put(static_cast<char>(value));
+}
+
+void writeU16(std::ostream& out, uint16_t value) {
+    writeU8(out, value & 0xFF);
+    writeU8(out, value >> 8);
+}
+
+void writeU32(std::ostream& out, uint32_t value) {
+    writeU16(out, value & 0xFFFF);
+    writeU16(out, value >> 16);
+}
+
+void writeVarint(std::ostream& out, uint32_t value) {
+    while (value >= 0x80) {
+        writeU8(out, static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    writeU8(out, static_cast<uint8_t>(value));
+}
+
+bool readU8(std::istream& in, uint8_t& value) {
+    int c = in.get();
+    if (c == EOF) return false;
+    value = static_cast<uint8_t>(c);
+    return true;
+}
+
+bool readU16(std::istream& in, uint16_t& value) {
+    uint8_t low, high;
+    if (!readU8(in, low) || !readU8(in, high)) return false;
+    value = static_cast<uint16_t>(low | (high << 8));
+    return true;
+}
+
+bool readU32(std::istream& in, uint32_t& value) {
+    uint16_t low, high;
+    if (!readU16(in, low) || !readU16(in, high)) return false;
+    value = static_cast<uint32_t>(low) | (static_cast<uint32_t>(high) << 16);
+    return true;
+}
+
+bool readVarint(std::istream& in, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        uint8_t byte;
+        if (!readU8(in, byte)) return false;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+}
+
+bool Replay::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open replay for writing").field("path", path);
+        return false;
+    }
+    
+    file.write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    writeU8(file, REPLAY_VERSION);
+    writeU16(file, tickRate);
+    writeU16(file, levelNumber);
+    writeU32(file, seed);
+    writeU32(file, static_cast<uint32_t>(inputs.size()));
+    
+    // Run-length encode: input tends to stay the same for many ticks
+    size_t i = 0;
+    while (i < inputs.size()) {
+        uint8_t buttons = inputs[i].buttons;
+        size_t run = 1;
+        while (i + run < inputs.size() && inputs[i + run].buttons == buttons) {
+            run++;
+        }
+        writeU8(file, buttons);
+        writeVarint(file, static_cast<uint32_t>(run));
+        i += run;
+    }
+    
+    return file.good();
+}
+
+bool Replay::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open replay").field("path", path);
+        return false;
+    }
+    
+    char magic[sizeof(REPLAY_MAGIC)];
+    uint8_t version;
+    uint32_t tickCount;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, REPLAY_MAGIC, sizeof(magic)) != 0 ||
+        !readU8(file, version) || version != REPLAY_VERSION ||
+        !readU16(file, tickRate) || !readU16(file, levelNumber) ||
+        !readU32(file, seed) || !readU32(file, tickCount) || tickRate == 0 || tickCount > MAX_REPLAY_TICKS) {
+        LOG_ERROR("Not a supported replay file").field("path", path);
+        return false;
+    }
+    
+    inputs.clear();
+    inputs.reserve(tickCount);
+    while (inputs.size() < tickCount) {
+        InputState input;
+        uint32_t run;
+        if (!readU8(file, input.buttons) || !readVarint(file, run) || run == 0 ||
+            run > tickCount - inputs.size()) {
+            LOG_ERROR("Truncated or corrupt replay").field("path", path);
+            return false;
+        }
+        inputs.insert(inputs.end(), run, input);
+    }
+    
+    return true;
+}
+
+bool Replay::startLevel(Level* level) const {
+    if (levelNumber == 0) {
+        level->loadTestLevel(seed);
+        return true;
+    }
+    return level->loadFromFile(levelNumber);
+}
+
+InputState ReplayRecorder::poll() {
+    InputState input = source ? source->poll() : InputState();
+    replay->inputs.push_back(input);
+    return input;
+}
+
+ReplayPlayer::ReplayPlayer(const Replay* replay, Level* level) 
+    : replay(replay), level(level), tick(0) {
+}
+
+bool ReplayPlayer::restart() {
+    tick = 0;
+    level->setInputProvider(this);
+    return replay->startLevel(level);
+}
+
+int ReplayPlayer::step(int ticks) {
+    const float tickDuration = getTickDuration();
+    int simulated = 0;
+    
+    while (simulated < ticks && !isFinished()) {
+        if (tick % KEYFRAME_INTERVAL == 0 && tick / KEYFRAME_INTERVAL == static_cast<int>(keyframes.size())) {
+            keyframes.emplace_back();
+            level->saveSnapshot(keyframes.back());
+        }
+        level->update(tickDuration);
+        simulated++;
+    }
+    return simulated;
+}
+
+bool ReplayPlayer::seek(int targetTick) {
+    if (targetTick < 0 || targetTick > getLength()) return false;
+    
+    if (targetTick < tick) {
+        size_t keyframe = static_cast<size_t>(targetTick / KEYFRAME_INTERVAL);
+        if (keyframe < keyframes.size() && level->restoreSnapshot(keyframes[keyframe])) {
+            tick = static_cast<int>(keyframe) * KEYFRAME_INTERVAL;
+            level->setInputProvider(this);
+        } else if (!restart()) {
+            return false;
+        }
+    }
+    step(targetTick - tick);
+    return true;
+}
+
+InputState ReplayPlayer::poll() {
+    // Murphy polls once per Level::update, so this is also the tick counter
+    if (tick >= getLength()) {
+        return InputState();
+    }
+    return replay->inputs[tick++];
+}
@@ -0,0 +1,74 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include "../main.hpp"
+#include "../systems/InputProvider.hpp"
+#include <string>
+#include <vector>
+
+class Level;
+
+// Everything needed to reproduce a run: which level (0 = random test level
+// from `seed`), the tick rate and the buttons held on every tick.
+//
+// .sprec layout (little endian):
+//   "SPRC" magic, u8 version, u16 tick rate, u16 level number, u32 seed,
+//   u32 tick count, then runs of (u8 buttons, varint run length).
+struct Replay {
+    uint16_t levelNumber = 1;
+    uint32_t seed = 0;
+    uint16_t tickRate = 35;
+    std::vector<InputState> inputs;  // One entry per tick
+    
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+    
+    // Reset `level` to the state the replay starts from
+    bool startLevel(Level* level) const;
+};
+
+// Passes input through from another provider while appending it to a replay
+class ReplayRecorder : public InputProvider {
+public:
+    ReplayRecorder(InputProvider* source, Replay* replay) : source(source), replay(replay) {}
+    
+    InputState poll() override;
+    
+private:
+    InputProvider* source;
+    Replay* replay;
+};
+
+// Feeds a replay's inputs back through Level::update, as fast as asked
+class ReplayPlayer : public InputProvider {
+public:
+    ReplayPlayer(const Replay* replay, Level* level);
+    
+    bool restart();
+    
+    // Advance up to `ticks` ticks; returns how many were simulated
+    int step(int ticks = 1);
+    
+    // Move to an absolute tick. Going back restores the nearest keyframe at or
+    // before the target and re-simulates only from there.
+    bool seek(int tick);
+    
+    int getTick() const { return tick; }
+    int getLength() const { return static_cast<int>(replay->inputs.size()); }
+    bool isFinished() const { return tick >= getLength(); }
+    float getTickDuration() const { return 1.0f / replay->tickRate; }
+    
+    InputState poll() override;
+    
+private:
+    const Replay* replay;
+    Level* level;
+    int tick;
+    
+    // Level snapshots taken every KEYFRAME_INTERVAL ticks while stepping;
+    // keyframes[i] is the state at tick i * KEYFRAME_INTERVAL
+    std::vector<std::vector<uint8_t>> keyframes;
+    static constexpr int KEYFRAME_INTERVAL = 350;  // 10 seconds at 35 Hz
+};
+
+#endif // REPLAY_HPP
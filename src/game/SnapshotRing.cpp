@@ -0,0 +1,124 @@
+#include "SnapshotRing.hpp"
+#include <algorithm>
+
+namespace {
+
+void writeVarint(std::vector<uint8_t>& out, size_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+size_t readVarint(const uint8_t*& data, const uint8_t* end) {
+    size_t value = 0;
+    int shift = 0;
+    while (data < end) {
+        uint8_t byte = *data++;
+        value |= static_cast<size_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) break;
+        shift += 7;
+    }
+    return value;
+}
+
+}
+
+SnapshotRing::SnapshotRing(size_t capacity)
+    : deltas(capacity > 1 ? capacity - 1 : 0), head(0), count(0) {
+}
+
+void SnapshotRing::push(const std::vector<uint8_t>& snapshot) {
+    if (count > 0 && !deltas.empty()) {
+        // Overwrites the oldest delta once full, dropping the oldest snapshot
+        encodeDelta(snapshot, newest, deltas[head]);
+        head = (head + 1) % deltas.size();
+        count = std::min(count + 1, getCapacity());
+    } else {
+        count = 1;
+    }
+    newest = snapshot;
+}
+
+bool SnapshotRing::pop(std::vector<uint8_t>& snapshot) {
+    if (count == 0) return false;
+    
+    snapshot = newest;
+    count--;
+    if (count > 0) {
+        head = (head + deltas.size() - 1) % deltas.size();
+        applyDelta(newest, deltas[head]);
+    }
+    return true;
+}
+
+void SnapshotRing::clear() {
+    head = 0;
+    count = 0;
+}
+
+void SnapshotRing::setCapacity(size_t capacity) {
+    deltas.resize(capacity > 1 ? capacity - 1 : 0);
+    clear();
+}
+
+size_t SnapshotRing::getMemoryUsage() const {
+    size_t total = newest.capacity();
+    for (const std::vector<uint8_t>& delta : deltas) {
+        total += delta.capacity();
+    }
+    return total;
+}
+
+void SnapshotRing::encodeDelta(const std::vector<uint8_t>& from, const std::vector<uint8_t>& to, std::vector<uint8_t>& delta) {
+    // Layout: varint size of `to`, then (varint skip, varint length, length XOR bytes)
+    // runs. Bytes past the end of the shorter buffer count as zero.
+    delta.clear();
+    writeVarint(delta, to.size());
+    
+    const size_t length = std::max(from.size(), to.size());
+    auto byteAt = [](const std::vector<uint8_t>& buffer, size_t i) -> uint8_t {
+        return i < buffer.size() ? buffer[i] : 0;
+    };
+    
+    size_t i = 0;
+    size_t runEnd = 0;
+    while (i < length) {
+        if (byteAt(from, i) == byteAt(to, i)) {
+            i++;
+            continue;
+        }
+        
+        size_t start = i;
+        while (i < length && byteAt(from, i) != byteAt(to, i)) {
+            i++;
+        }
+        writeVarint(delta, start - runEnd);
+        writeVarint(delta, i - start);
+        for (size_t j = start; j < i; j++) {
+            delta.push_back(byteAt(from, j) ^ byteAt(to, j));
+        }
+        runEnd = i;
+    }
+}
+
+void SnapshotRing::applyDelta(std::vector<uint8_t>& snapshot, const std::vector<uint8_t>& delta) {
+    const uint8_t* data = delta.data();
+    const uint8_t* end = data + delta.size();
+    
+    size_t targetSize = readVarint(data, end);
+    if (snapshot.size() < targetSize) {
+        snapshot.resize(targetSize, 0);
+    }
+    
+    size_t position = 0;
+    while (data < end) {
+        position += readVarint(data, end);
+        size_t length = readVarint(data, end);
+        for (size_t j = 0; j < length && data < end && position < snapshot.size(); j++) {
+            snapshot[position++] ^= *data++;
+        }
+    }
+    snapshot.resize(targetSize);
+}
@@ -0,0 +1,38 @@
+#ifndef SNAPSHOTRING_HPP
+#define SNAPSHOTRING_HPP
+
+#include "../main.hpp"
+#include <vector>
+
+// Rewind history for Level snapshots. Only the newest snapshot is kept in
+// full; each older one is stored as a reverse delta (XOR against its successor,
+// zero runs skipped), which is small since most objects don't change between
+// ticks. Buffers are reused once the ring is full, so pushing every tick
+// doesn't allocate in steady state.
+class SnapshotRing {
+public:
+    explicit SnapshotRing(size_t capacity);
+    
+    void push(const std::vector<uint8_t>& snapshot);
+    
+    // Take the newest snapshot off the ring; false when empty
+    bool pop(std::vector<uint8_t>& snapshot);
+    
+    void clear();
+    // Drops every snapshot; buffers already grown are kept where they still fit
+    void setCapacity(size_t capacity);
+    size_t size() const { return count; }
+    size_t getCapacity() const { return deltas.size() + 1; }
+    size_t getMemoryUsage() const;
+    
+private:
+    static void encodeDelta(const std::vector<uint8_t>& from, const std::vector<uint8_t>& to, std::vector<uint8_t>& delta);
+    static void applyDelta(std::vector<uint8_t>& snapshot, const std::vector<uint8_t>& delta);
+    
+    std::vector<uint8_t> newest;
+    std::vector<std::vector<uint8_t>> deltas;  // deltas[i] turns a snapshot into its predecessor
+    size_t head;   // Slot the next delta goes into
+    size_t count;  // Snapshots held, including `newest`
+};
+
+#endif // SNAPSHOTRING_HPP
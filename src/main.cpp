@@ -1,9 +1,16 @@
 #include "main.hpp"
 #include "game/Game.hpp"
+#include <string>
 
 int main(int argc, char* argv[])
 {
     Game game;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--startup-trace") {
+            game.setStartupReport(true);
+        }
+    }
     game.run();
     
     return 0;
@@ -0,0 +1,93 @@
+#include "AllocationCounter.hpp"
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#ifdef SUPAPLEX_COUNT_ALLOCATIONS
+
+namespace {
+
+// Plain thread_locals with constant initializers, so touching them from
+// operator new can't itself allocate
+thread_local uint64_t allocationCount = 0;
+thread_local uint64_t allocationBytes = 0;
+
+void* countedAlloc(size_t size) {
+    allocationCount++;
+    allocationBytes += size;
+    return std::malloc(size ? size : 1);
+}
+
+void* countedAlignedAlloc(size_t size, size_t alignment) {
+    allocationCount++;
+    allocationBytes += size;
+    
+#ifdef _WIN32
+    return _aligned_malloc(size ? size : 1, alignment);
+#else
+    // aligned_alloc wants the size rounded up to the alignment
+    size_t rounded = (size + alignment - 1) / alignment * alignment;
+    return std::aligned_alloc(alignment, rounded ? rounded : alignment);
+#endif
+}
+
+void alignedFree(void* memory) {
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+}
+
+void* operator new(size_t size) {
+    void* memory = countedAlloc(size);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new[](size_t size) {
+    void* memory = countedAlloc(size);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    void* memory = countedAlignedAlloc(size, static_cast<size_t>(alignment));
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    void* memory = countedAlignedAlloc(size, static_cast<size_t>(alignment));
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { alignedFree(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { alignedFree(memory); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept { alignedFree(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept { alignedFree(memory); }
+
+bool AllocationCounter::isEnabled() { return true; }
+uint64_t AllocationCounter::getCount() { return allocationCount; }
+uint64_t AllocationCounter::getBytes() { return allocationBytes; }
+
+#else
+
+bool AllocationCounter::isEnabled() { return false; }
+uint64_t AllocationCounter::getCount() { return 0; }
+uint64_t AllocationCounter::getBytes() { return 0; }
+
+#endif
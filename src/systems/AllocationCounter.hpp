@@ -0,0 +1,18 @@
+#ifndef ALLOCATIONCOUNTER_HPP
+#define ALLOCATIONCOUNTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Heap allocations made by the calling thread. Builds with
+// SUPAPLEX_COUNT_ALLOCATIONS (Debug by default) replace the global operator
+// new/delete to count them; other builds report zero. malloc calls inside
+// SDL and the C library aren't seen.
+class AllocationCounter {
+public:
+    static bool isEnabled();
+    static uint64_t getCount();
+    static uint64_t getBytes();
+};
+
+#endif // ALLOCATIONCOUNTER_HPP
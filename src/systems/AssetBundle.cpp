@@ -0,0 +1,302 @@
+#include "AssetBundle.hpp"
+#include "Log.hpp"
+#include "Lz4.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+template<typename T>
+T readField(const uint8_t* data, size_t offset) {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+uint64_t hashBytes(const uint8_t* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+template<typename T>
+void writeField(std::vector<uint8_t>& out, T value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+}
+
+bool AssetBundle::open(const std::string& path) {
+    close();
+    
+    if (!file.open(path)) {
+        return false;
+    }
+    
+    const uint8_t* data = file.data();
+    size_t size = file.size();
+    if (size < HEADER_SIZE || readField<uint32_t>(data, 0) != MAGIC) {
+        LOG_ERROR("Not an asset bundle").field("path", path);
+        close();
+        return false;
+    }
+    if (readField<uint32_t>(data, 4) != VERSION) {
+        LOG_ERROR("Unsupported asset bundle version").field("path", path).field("version", readField<uint32_t>(data, 4));
+        close();
+        return false;
+    }
+    
+    uint32_t entryCount = readField<uint32_t>(data, 8);
+    if (entryCount > (size - HEADER_SIZE) / ENTRY_RECORD_SIZE) {
+        LOG_ERROR("Corrupt asset bundle").field("path", path);
+        close();
+        return false;
+    }
+    
+    entries.reserve(entryCount);
+    for (uint32_t i = 0; i < entryCount; i++) {
+        const uint8_t* record = data + HEADER_SIZE + i * ENTRY_RECORD_SIZE;
+        
+        Entry entry;
+        entry.name.assign(reinterpret_cast<const char*>(record), strnlen(reinterpret_cast<const char*>(record), NAME_SIZE));
+        entry.type = static_cast<EntryType>(record[16]);
+        entry.compression = static_cast<Compression>(record[17]);
+        entry.width = readField<uint32_t>(record, 20);
+        entry.height = readField<uint32_t>(record, 24);
+        entry.offset = readField<uint32_t>(record, 28);
+        entry.storedSize = readField<uint32_t>(record, 32);
+        entry.rawSize = readField<uint32_t>(record, 36);
+        entry.source.size = readField<uint64_t>(record, 40);
+        entry.source.modifiedTime = readField<int64_t>(record, 48);
+        entry.source.hash = readField<uint64_t>(record, 56);
+        const char* sourcePath = reinterpret_cast<const char*>(record + 64);
+        entry.source.path.assign(sourcePath, strnlen(sourcePath, SOURCE_PATH_SIZE));
+        
+        bool inBounds = entry.offset <= size && entry.storedSize <= size - entry.offset;
+        bool sizesMatch = entry.compression == Compression::LZ4 || entry.storedSize == entry.rawSize;
+        bool imageSizeMatches = entry.type != EntryType::IMAGE ||
+                                uint64_t(entry.width) * entry.height * 4 == entry.rawSize;
+        if (!inBounds || !sizesMatch || !imageSizeMatches || entry.compression > Compression::LZ4) {
+            LOG_ERROR("Corrupt asset bundle entry").field("path", path).field("entry", entry.name);
+            close();
+            return false;
+        }
+        entries.push_back(entry);
+    }
+    
+    return true;
+}
+
+void AssetBundle::close() {
+    file.close();
+    entries.clear();
+}
+
+const AssetBundle::Entry* AssetBundle::find(const std::string& name) const {
+    for (const Entry& entry : entries) {
+        if (entry.name == name) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const uint8_t* AssetBundle::getRawData(const Entry& entry, std::vector<uint8_t>& buffer) const {
+    if (entry.compression == Compression::NONE) {
+        return getStoredData(entry);
+    }
+    
+    buffer.resize(entry.rawSize);
+    if (!Lz4::decompress(getStoredData(entry), entry.storedSize, buffer.data(), buffer.size())) {
+        LOG_ERROR("Corrupt compressed data in asset bundle").field("entry", entry.name);
+        return nullptr;
+    }
+    return buffer.data();
+}
+
+std::vector<SDL_Rect> AssetBundle::parseSpriteTable(const uint8_t* data, size_t size) {
+    std::vector<SDL_Rect> rects;
+    if (size < 4) {
+        return rects;
+    }
+    
+    uint32_t count = readField<uint32_t>(data, 0);
+    if (count > (size - 4) / 8) {
+        return rects;
+    }
+    
+    rects.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t* record = data + 4 + i * 8;
+        rects[i] = {readField<uint16_t>(record, 0), readField<uint16_t>(record, 2),
+                    readField<uint16_t>(record, 4), readField<uint16_t>(record, 6)};
+    }
+    return rects;
+}
+
+namespace {
+
+bool statFile(const std::string& path, uint64_t& size, int64_t& modifiedTime) {
+    std::error_code error;
+    uintmax_t fileSize = std::filesystem::file_size(path, error);
+    if (error) {
+        return false;
+    }
+    auto modified = std::filesystem::last_write_time(path, error);
+    if (error) {
+        return false;
+    }
+    size = fileSize;
+    modifiedTime = static_cast<int64_t>(modified.time_since_epoch().count());
+    return true;
+}
+
+bool hashFile(const std::string& path, uint64_t& hash) {
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    hash = hashBytes(file.data(), file.size());
+    return true;
+}
+
+}
+
+bool AssetBundle::stampFile(const std::string& path, SourceStamp& stamp) {
+    stamp.path = path;
+    if (!statFile(path, stamp.size, stamp.modifiedTime) || !hashFile(path, stamp.hash)) {
+        stamp = SourceStamp();
+        return false;
+    }
+    return true;
+}
+
+bool AssetBundle::isStale(const Entry& entry) {
+    const SourceStamp& packed = entry.source;
+    uint64_t size;
+    int64_t modifiedTime;
+    if (packed.path.empty() || !statFile(packed.path, size, modifiedTime)) {
+        return false;
+    }
+    if (size != packed.size) {
+        return true;
+    }
+    if (modifiedTime == packed.modifiedTime) {
+        return false;
+    }
+    
+    // Same size, different time: copied or checked out again, maybe edited
+    uint64_t hash;
+    return hashFile(packed.path, hash) && hash != packed.hash;
+}
+
+void AssetBundleWriter::addImage(const std::string& name, uint32_t width, uint32_t height, const uint8_t* rgba,
+                                 bool compress, const std::string& sourcePath) {
+    AssetBundle::Entry entry{name, AssetBundle::EntryType::IMAGE, AssetBundle::Compression::NONE, width, height, 0, 0, 0, {}};
+    AssetBundle::stampFile(sourcePath, entry.source);
+    add(entry, rgba, size_t(width) * height * 4, compress);
+}
+
+void AssetBundleWriter::addBlob(const std::string& name, const uint8_t* data, size_t size, bool compress,
+                                const std::string& sourcePath) {
+    AssetBundle::Entry entry{name, AssetBundle::EntryType::BLOB, AssetBundle::Compression::NONE, 0, 0, 0, 0, 0, {}};
+    AssetBundle::stampFile(sourcePath, entry.source);
+    add(entry, data, size, compress);
+}
+
+void AssetBundleWriter::addSpriteTable(const std::string& name, const std::vector<SDL_Rect>& rects,
+                                       const std::string& sourcePath) {
+    std::vector<uint8_t> table;
+    writeField<uint32_t>(table, static_cast<uint32_t>(rects.size()));
+    for (const SDL_Rect& rect : rects) {
+        writeField<uint16_t>(table, static_cast<uint16_t>(rect.x));
+        writeField<uint16_t>(table, static_cast<uint16_t>(rect.y));
+        writeField<uint16_t>(table, static_cast<uint16_t>(rect.w));
+        writeField<uint16_t>(table, static_cast<uint16_t>(rect.h));
+    }
+    
+    AssetBundle::Entry entry{name, AssetBundle::EntryType::SPRITE_TABLE, AssetBundle::Compression::NONE, 0, 0, 0, 0, 0, {}};
+    AssetBundle::stampFile(sourcePath, entry.source);
+    add(entry, table.data(), table.size(), false);
+}
+
+void AssetBundleWriter::add(AssetBundle::Entry entry, const uint8_t* data, size_t size, bool compress) {
+    entry.rawSize = static_cast<uint32_t>(size);
+    
+    std::vector<uint8_t> payload;
+    if (compress) {
+        payload = Lz4::compress(data, size);
+    }
+    // Only keep the compressed form when it actually saves space
+    if (compress && payload.size() < size) {
+        entry.compression = AssetBundle::Compression::LZ4;
+    } else {
+        payload.assign(data, data + size);
+    }
+    entry.storedSize = static_cast<uint32_t>(payload.size());
+    
+    entries.push_back(entry);
+    payloads.push_back(std::move(payload));
+}
+
+bool AssetBundleWriter::write(const std::string& path) const {
+    for (const AssetBundle::Entry& entry : entries) {
+        if (entry.name.size() > AssetBundle::NAME_SIZE) {
+            LOG_ERROR("Asset bundle entry name too long").field("entry", entry.name);
+            return false;
+        }
+        if (entry.source.path.size() > AssetBundle::SOURCE_PATH_SIZE) {
+            LOG_ERROR("Asset bundle source path too long").field("entry", entry.name).field("path", entry.source.path);
+            return false;
+        }
+    }
+    
+    std::vector<uint8_t> out;
+    writeField<uint32_t>(out, AssetBundle::MAGIC);
+    writeField<uint32_t>(out, AssetBundle::VERSION);
+    writeField<uint32_t>(out, static_cast<uint32_t>(entries.size()));
+    writeField<uint32_t>(out, 0);
+    
+    size_t offset = AssetBundle::HEADER_SIZE + entries.size() * AssetBundle::ENTRY_RECORD_SIZE;
+    for (size_t i = 0; i < entries.size(); i++) {
+        const AssetBundle::Entry& entry = entries[i];
+        offset = (offset + AssetBundle::DATA_ALIGNMENT - 1) & ~(AssetBundle::DATA_ALIGNMENT - 1);
+        
+        char name[AssetBundle::NAME_SIZE] = {};
+        std::memcpy(name, entry.name.data(), entry.name.size());
+        out.insert(out.end(), name, name + AssetBundle::NAME_SIZE);
+        out.push_back(static_cast<uint8_t>(entry.type));
+        out.push_back(static_cast<uint8_t>(entry.compression));
+        writeField<uint16_t>(out, 0);
+        writeField<uint32_t>(out, entry.width);
+        writeField<uint32_t>(out, entry.height);
+        writeField<uint32_t>(out, static_cast<uint32_t>(offset));
+        writeField<uint32_t>(out, entry.storedSize);
+        writeField<uint32_t>(out, entry.rawSize);
+        writeField<uint64_t>(out, entry.source.size);
+        writeField<int64_t>(out, entry.source.modifiedTime);
+        writeField<uint64_t>(out, entry.source.hash);
+        char sourcePath[AssetBundle::SOURCE_PATH_SIZE] = {};
+        std::memcpy(sourcePath, entry.source.path.data(), entry.source.path.size());
+        out.insert(out.end(), sourcePath, sourcePath + AssetBundle::SOURCE_PATH_SIZE);
+        
+        offset += payloads[i].size();
+    }
+    
+    for (const std::vector<uint8_t>& payload : payloads) {
+        out.resize((out.size() + AssetBundle::DATA_ALIGNMENT - 1) & ~(AssetBundle::DATA_ALIGNMENT - 1), 0);
+        out.insert(out.end(), payload.begin(), payload.end());
+    }
+    
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        LOG_ERROR("Failed to write asset bundle").field("path", path);
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(out.data()), out.size());
+    return file.good();
+}
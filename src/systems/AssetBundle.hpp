@@ -0,0 +1,110 @@
+#ifndef ASSETBUNDLE_HPP
+#define ASSETBUNDLE_HPP
+
+#include "../main.hpp"
+#include "MappedFile.hpp"
+#include <string>
+#include <vector>
+
+// Single-file bundle of pre-decoded assets, written offline by supaplex-pack
+// and memory-mapped at startup. Layout (native byte order):
+//   header:  u32 magic, u32 version, u32 entry count, u32 reserved
+//   entries: ENTRY_RECORD_SIZE bytes each (name, type, compression, image
+//            size, offset/stored size/raw size of the data, then the size,
+//            modification time, content hash and path of the source file
+//            it was built from)
+//   data:    each entry's bytes, aligned to DATA_ALIGNMENT
+// Images are raw RGBA32 rows with no padding, optionally LZ4-compressed.
+class AssetBundle {
+public:
+    enum class EntryType : uint8_t {
+        IMAGE = 0,
+        BLOB = 1,          // Opaque bytes, e.g. the level pack
+        SPRITE_TABLE = 2   // u32 count, then u16 x, y, w, h per sprite
+    };
+    
+    enum class Compression : uint8_t {
+        NONE = 0,
+        LZ4 = 1
+    };
+    
+    // The loose file an entry was packed from; empty path when the entry has
+    // no source of its own. The hash decides: copies and checkouts rewrite
+    // the modification time, which only saves hashing when it still matches.
+    struct SourceStamp {
+        std::string path;
+        uint64_t size = 0;
+        int64_t modifiedTime = 0;  // Filesystem clock ticks, not portable across builds
+        uint64_t hash = 0;         // FNV-1a over the file's bytes
+    };
+    
+    struct Entry {
+        std::string name;
+        EntryType type;
+        Compression compression;
+        uint32_t width;   // Images only
+        uint32_t height;
+        uint32_t offset;  // From the start of the bundle
+        uint32_t storedSize;
+        uint32_t rawSize;
+        SourceStamp source;
+    };
+    
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+    
+    const Entry* find(const std::string& name) const;
+    const std::vector<Entry>& getEntries() const { return entries; }
+    size_t getSize() const { return file.size(); }
+    
+    // Bytes as stored, pointing into the mapping
+    const uint8_t* getStoredData(const Entry& entry) const { return file.data() + entry.offset; }
+    
+    // Uncompressed bytes: the mapping itself when stored raw, otherwise
+    // decompressed into `buffer`. Returns nullptr on corrupt data.
+    const uint8_t* getRawData(const Entry& entry, std::vector<uint8_t>& buffer) const;
+    
+    static std::vector<SDL_Rect> parseSpriteTable(const uint8_t* data, size_t size);
+    
+    // Stamp of the file at `path`, hash included; false when it can't be read
+    static bool stampFile(const std::string& path, SourceStamp& stamp);
+    // True when the entry's source file exists with different contents, i.e.
+    // it was edited after the bundle was built. A missing source file means a
+    // bundle-only install, which is never stale.
+    static bool isStale(const Entry& entry);
+    
+    static const uint32_t MAGIC = 0x42585053;  // "SPXB"
+    static const uint32_t VERSION = 3;
+    static const size_t HEADER_SIZE = 16;
+    static const size_t NAME_SIZE = 16;
+    static const size_t SOURCE_PATH_SIZE = 96;
+    static const size_t ENTRY_RECORD_SIZE = 64 + SOURCE_PATH_SIZE;
+    static const size_t DATA_ALIGNMENT = 16;
+    
+private:
+    MappedFile file;
+    std::vector<Entry> entries;
+};
+
+// Builds a bundle in memory and writes it out in one go
+class AssetBundleWriter {
+public:
+    // `rgba` is width * height tightly packed RGBA32 pixels. `sourcePath` is
+    // the loose file the entry was made from, stamped for the staleness check.
+    void addImage(const std::string& name, uint32_t width, uint32_t height, const uint8_t* rgba, bool compress,
+                  const std::string& sourcePath);
+    void addBlob(const std::string& name, const uint8_t* data, size_t size, bool compress, const std::string& sourcePath);
+    void addSpriteTable(const std::string& name, const std::vector<SDL_Rect>& rects, const std::string& sourcePath);
+    
+    bool write(const std::string& path) const;
+    const std::vector<AssetBundle::Entry>& getEntries() const { return entries; }
+    
+private:
+    void add(AssetBundle::Entry entry, const uint8_t* data, size_t size, bool compress);
+    
+    std::vector<AssetBundle::Entry> entries;   // Offsets are assigned in write()
+    std::vector<std::vector<uint8_t>> payloads;
+};
+
+#endif // ASSETBUNDLE_HPP
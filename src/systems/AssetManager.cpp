@@ -1,57 +1,220 @@
 #include "AssetManager.hpp"
+#include "Log.hpp"
+#include "StartupTrace.hpp"
 #include <SDL2/SDL_image.h>
+#include <algorithm>
 
 AssetManager& AssetManager::getInstance() {
     static AssetManager instance;
     return instance;
 }
 
-bool AssetManager::initialize(SDL_Renderer* renderer) {
+const AssetManifestEntry AssetManager::MANIFEST[] = {
+    {"sprites", "assets/gfx/RocksSP.png", true},
+    {"panel", "assets/gfx/panel.png", true},
+    {"frame", "assets/gfx/frame.png", false},
+};
+const size_t AssetManager::MANIFEST_SIZE = sizeof(MANIFEST) / sizeof(MANIFEST[0]);
+
+const char* const AssetManager::BUNDLE_PATH = "assets/supaplex.bundle";
+const char* const AssetManager::SPRITE_TABLE_ENTRY = "sprites.meta";
+const char* const AssetManager::LEVEL_PACK_ENTRY = "levels";
+const char* const AssetManager::LEVEL_PACK_PATH = "assets/LEVELS.DAT";
+
+bool AssetManager::startLoading() {
+    if (!pendingImages.empty()) return true;
+    
+    {
+        StartupPhase phase("Open asset bundle");
+        bundle.open(BUNDLE_PATH);
+        
+        // Loose files edited after the bundle was built take precedence
+        staleEntries.clear();
+        for (const AssetBundle::Entry& entry : bundle.getEntries()) {
+            if (AssetBundle::isStale(entry)) {
+                LOG_WARN("Asset bundle entry is out of date, loading the loose file")
+                    .field("entry", entry.name)
+                    .field("path", entry.source.path);
+                staleEntries.push_back(entry.name);
+            }
+        }
+    }
+    
+    // SDL_image is only needed for images missing from the bundle
+    bool needsImageLoader = false;
+    for (size_t i = 0; i < MANIFEST_SIZE; i++) {
+        const AssetBundle::Entry* entry = findCurrent(MANIFEST[i].name);
+        needsImageLoader |= !entry || entry->type != AssetBundle::EntryType::IMAGE;
+    }
+    if (needsImageLoader) {
+        int imgFlags = IMG_INIT_PNG;
+        if (!(IMG_Init(imgFlags) & imgFlags)) {
+            LOG_ERROR("SDL_image could not initialize").field("error", IMG_GetError());
+            return false;
+        }
+    }
+    
+    startDecoding();
+    return true;
+}
+
+void AssetManager::startDecoding() {
+    // Surfaces don't need the renderer, so each image decodes on its own thread
+    for (size_t i = 0; i < MANIFEST_SIZE; i++) {
+        const AssetBundle::Entry* entry = findCurrent(MANIFEST[i].name);
+        if (entry && entry->type == AssetBundle::EntryType::IMAGE) {
+            pendingImages.push_back(std::async(std::launch::async, &AssetManager::decodeBundleImage, this, entry));
+        } else {
+            pendingImages.push_back(std::async(std::launch::async, decodeImage, MANIFEST[i].path));
+        }
+    }
+}
+
+bool AssetManager::finishLoading(SDL_Renderer* renderer) {
     this->renderer = renderer;
+    bool success = !pendingImages.empty();
     
-    // Initialize SDL_image
-    int imgFlags = IMG_INIT_PNG;
-    if (!(IMG_Init(imgFlags) & imgFlags)) {
-        std::cerr << "SDL_image could not initialize! SDL_image Error: " << IMG_GetError() << std::endl;
-        return false;
+    // Collect every image even after a failure, so no surface leaks
+    for (size_t i = 0; i < pendingImages.size(); i++) {
+        const AssetManifestEntry& entry = MANIFEST[i];
+        DecodedImage image;
+        {
+            StartupPhase phase(std::string("Wait for ") + entry.path);
+            image = pendingImages[i].get();
+        }
+        
+        SDL_Texture* texture = nullptr;
+        if (image.surface) {
+            StartupPhase phase(std::string("Upload ") + entry.name);
+            texture = SDL_CreateTextureFromSurface(renderer, image.surface);
+            SDL_FreeSurface(image.surface);
+            if (!texture) {
+                image.error = SDL_GetError();
+            }
+        }
+        
+        if (texture) {
+            addTexture(entry.name, texture);
+        } else {
+            LOG_ERROR("Unable to load image").field("path", entry.path).field("error", image.error);
+            if (entry.required) {
+                success = false;
+            }
+        }
     }
+    pendingImages.clear();
     
-    // Load the main sprite sheet
-    if (!loadTexture("sprites", "assets/gfx/RocksSP.png")) {
-        std::cerr << "Failed to load sprite sheet!" << std::endl;
-        return false;
+    // The bundle's sprite table saves deriving the layout from the sheet size
+    const uint8_t* table;
+    size_t tableSize;
+    std::vector<SDL_Rect> spriteRects;
+    if (getBundleData(SPRITE_TABLE_ENTRY, table, tableSize)) {
+        spriteRects = AssetBundle::parseSpriteTable(table, tableSize);
+    }
+    if (!spriteRects.empty()) {
+        spriteAtlas.build(getTexture("sprites"), spriteRects);
+    } else {
+        spriteAtlas.build(getTexture("sprites"));
+    }
+    return success;
+}
+
+bool AssetManager::initialize(SDL_Renderer* renderer) {
+    return startLoading() && finishLoading(renderer);
+}
+
+bool AssetManager::reloadTextures() {
+    if (!renderer || !pendingImages.empty()) return false;
+    
+    // The bundle stays mapped, since the level pack may point into it.
+    // Textures are replaced under their old handles.
+    startDecoding();
+    return finishLoading(renderer);
+}
+
+AssetManager::DecodedImage AssetManager::decodeImage(const char* path) {
+    StartupPhase phase(std::string("Decode ") + path);
+    
+    DecodedImage image;
+    image.surface = IMG_Load(path);
+    if (!image.surface) {
+        image.error = IMG_GetError();
     }
+    return image;
+}
+
+AssetManager::DecodedImage AssetManager::decodeBundleImage(const AssetBundle::Entry* entry) const {
+    StartupPhase phase("Unpack " + entry->name);
     
-    // Load the panel
-    if (!loadTexture("panel", "assets/gfx/panel.png")) {
-        std::cerr << "Failed to load panel!" << std::endl;
-        return false;
+    DecodedImage image;
+    const uint8_t* pixels = bundle.getRawData(*entry, image.pixels);
+    if (!pixels) {
+        image.error = "corrupt bundle entry";
+        return image;
     }
     
+    // Uncompressed pixels are wrapped in place, so the upload reads straight
+    // from the mapping. SDL only reads from the surface, despite the non-const API.
+    image.surface = SDL_CreateRGBSurfaceWithFormatFrom(const_cast<uint8_t*>(pixels), entry->width, entry->height,
+                                                       32, entry->width * 4, SDL_PIXELFORMAT_RGBA32);
+    if (!image.surface) {
+        image.error = SDL_GetError();
+    }
+    return image;
+}
+
+const AssetBundle::Entry* AssetManager::findCurrent(const std::string& name) const {
+    if (std::find(staleEntries.begin(), staleEntries.end(), name) != staleEntries.end()) {
+        return nullptr;
+    }
+    return bundle.find(name);
+}
+
+bool AssetManager::getBundleData(const std::string& name, const uint8_t*& data, size_t& size) const {
+    const AssetBundle::Entry* entry = findCurrent(name);
+    if (!entry || entry->compression != AssetBundle::Compression::NONE) {
+        return false;
+    }
+    data = bundle.getStoredData(*entry);
+    size = entry->rawSize;
     return true;
 }
 
+std::string AssetManager::getLevelPackPath() const {
+    const AssetBundle::Entry* entry = bundle.find(LEVEL_PACK_ENTRY);
+    return entry && !entry->source.path.empty() ? entry->source.path : LEVEL_PACK_PATH;
+}
+
 void AssetManager::cleanup() {
-    for (auto& pair : textures) {
-        SDL_DestroyTexture(pair.second);
+    spriteAtlas.clear();
+    for (SDL_Texture* texture : textures) {
+        SDL_DestroyTexture(texture);
     }
     textures.clear();
+    textureHandles.clear();
+    
+    // Drain a load that was started but never finished
+    for (auto& pending : pendingImages) {
+        SDL_FreeSurface(pending.get().surface);
+    }
+    pendingImages.clear();
+    bundle.close();
     
     IMG_Quit();
 }
 
-SDL_Texture* AssetManager::getTexture(const std::string& name) {
-    auto it = textures.find(name);
-    if (it != textures.end()) {
+AssetManager::TextureHandle AssetManager::getTextureHandle(const std::string& name) const {
+    auto it = textureHandles.find(name);
+    if (it != textureHandles.end()) {
         return it->second;
     }
-    return nullptr;
+    return INVALID_TEXTURE;
 }
 
 bool AssetManager::loadTexture(const std::string& name, const std::string& path) {
     SDL_Surface* loadedSurface = IMG_Load(path.c_str());
     if (!loadedSurface) {
-        std::cerr << "Unable to load image " << path << "! SDL_image Error: " << IMG_GetError() << std::endl;
+        LOG_ERROR("Unable to load image").field("path", path).field("error", IMG_GetError());
         return false;
     }
     
@@ -59,14 +222,26 @@ bool AssetManager::loadTexture(const std::string& name, const std::string& path)
     SDL_FreeSurface(loadedSurface);
     
     if (!texture) {
-        std::cerr << "Unable to create texture from " << path << "! SDL Error: " << SDL_GetError() << std::endl;
+        LOG_ERROR("Unable to create texture").field("path", path).field("error", SDL_GetError());
         return false;
     }
     
-    textures[name] = texture;
+    addTexture(name, texture);
     return true;
 }
 
+void AssetManager::addTexture(const std::string& name, SDL_Texture* texture) {
+    // Reloading a name keeps its handle valid
+    TextureHandle handle = getTextureHandle(name);
+    if (handle == INVALID_TEXTURE) {
+        textureHandles[name] = static_cast<TextureHandle>(textures.size());
+        textures.push_back(texture);
+    } else {
+        SDL_DestroyTexture(textures[handle]);
+        textures[handle] = texture;
+    }
+}
+
 int AssetManager::getTextureWidth(const std::string& name) {
     SDL_Texture* texture = getTexture(name);
     if (texture) {
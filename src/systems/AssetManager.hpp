@@ -2,19 +2,58 @@
 #define ASSETMANAGER_HPP
 
 #include "../main.hpp"
+#include "AssetBundle.hpp"
+#include "SpriteAtlas.hpp"
+#include <future>
 #include <unordered_map>
 #include <string>
+#include <vector>
+
+// Images the game loads at startup
+struct AssetManifestEntry {
+    const char* name;
+    const char* path;
+    bool required;  // Startup fails without it
+};
 
 class AssetManager {
 public:
     static AssetManager& getInstance();
     
-    bool initialize(SDL_Renderer* renderer);
+    // Loading is split in two so PNG decoding can overlap window and renderer
+    // creation: startLoading decodes every manifest image on worker threads,
+    // finishLoading waits for them and uploads the textures on the calling
+    // (render) thread. Images found in the asset bundle (BUNDLE_PATH) skip PNG
+    // decoding; the rest fall back to the loose files.
+    bool startLoading();
+    bool finishLoading(SDL_Renderer* renderer);
+    bool initialize(SDL_Renderer* renderer);  // Both of the above, back to back
+    // Decode and upload every image again after the renderer lost its
+    // textures (SDL_RENDER_DEVICE_RESET). Handles stay valid.
+    bool reloadTextures();
     void cleanup();
     
-    SDL_Texture* getTexture(const std::string& name);
+    // Textures are addressed by handle on hot paths: look the handle up once
+    // by name, then getTexture(handle) is an array index
+    using TextureHandle = int;
+    static const TextureHandle INVALID_TEXTURE = -1;
+    
+    TextureHandle getTextureHandle(const std::string& name) const;
+    SDL_Texture* getTexture(TextureHandle handle) const {
+        return handle >= 0 && handle < static_cast<int>(textures.size()) ? textures[handle] : nullptr;
+    }
+    SDL_Texture* getTexture(const std::string& name) const { return getTexture(getTextureHandle(name)); }
     bool loadTexture(const std::string& name, const std::string& path);
     
+    // Bundle opened by startLoading; closed if there is none
+    const AssetBundle& getBundle() const { return bundle; }
+    // Uncompressed blob from the bundle, straight from the mapping. False when
+    // the entry is missing or its loose source file changed since packing.
+    bool getBundleData(const std::string& name, const uint8_t*& data, size_t& size) const;
+    
+    // Sprite rects for the "sprites" sheet; valid (but empty) before loading
+    const SpriteAtlas& getSpriteAtlas() const { return spriteAtlas; }
+    
     // Get texture dimensions
     int getTextureWidth(const std::string& name);
     int getTextureHeight(const std::string& name);
@@ -23,12 +62,42 @@ public:
     static const int SPRITE_SIZE = 16;     // Fixed back to 16
     static const int SPRITES_PER_ROW = 16;
     
+    static const AssetManifestEntry MANIFEST[];
+    static const size_t MANIFEST_SIZE;
+    
+    static const char* const BUNDLE_PATH;
+    static const char* const SPRITE_TABLE_ENTRY;  // Sprite rects for "sprites"
+    static const char* const LEVEL_PACK_ENTRY;    // LEVELS.DAT
+    static const char* const LEVEL_PACK_PATH;     // Loose levels file
+    
+    // Levels file the bundle's level pack was built from, or the default
+    // loose file; where to load levels from when the entry is unusable
+    std::string getLevelPackPath() const;
+    
 private:
-    AssetManager() = default;
+    AssetManager() : renderer(nullptr) {}
     ~AssetManager() = default;
     
+    struct DecodedImage {
+        SDL_Surface* surface = nullptr;
+        std::vector<uint8_t> pixels;  // Backs surface when it was decompressed from the bundle
+        std::string error;
+    };
+    static DecodedImage decodeImage(const char* path);
+    DecodedImage decodeBundleImage(const AssetBundle::Entry* entry) const;
+    void startDecoding();
+    // Bundle entry, unless it's missing or out of date with its loose file
+    const AssetBundle::Entry* findCurrent(const std::string& name) const;
+    
+    void addTexture(const std::string& name, SDL_Texture* texture);
+    
     SDL_Renderer* renderer;
-    std::unordered_map<std::string, SDL_Texture*> textures;
+    AssetBundle bundle;
+    std::vector<std::string> staleEntries;  // Checked once when the bundle is opened
+    std::vector<std::future<DecodedImage>> pendingImages;  // One per manifest entry while loading
+    std::vector<SDL_Texture*> textures;
+    std::unordered_map<std::string, TextureHandle> textureHandles;
+    SpriteAtlas spriteAtlas;
 };
 
 #endif // ASSETMANAGER_HPP
\ No newline at end of file
@@ -2,25 +2,21 @@
 #define BORDERSPRITE_HPP
 
 #include "../main.hpp"
+#include "SpriteAtlas.hpp"
+#include "SpriteBatch.hpp"
 
 class BorderSprite {
 public:
     BorderSprite();
-    BorderSprite(SDL_Texture* texture, int spriteId);
+    BorderSprite(const SpriteAtlas* atlas, int spriteId);
     
-    void setSpriteId(int spriteId);
-    void render(SDL_Renderer* renderer, int x, int y, int quarter);
-    void renderWithSprite(SDL_Renderer* renderer, int x, int y, int spriteId, int quarter);
+    void setSpriteId(int spriteId) { this->spriteId = spriteId; }
+    void render(SpriteBatch& batch, int x, int y, int quarter);
+    void renderWithSprite(SpriteBatch& batch, int x, int y, int spriteId, int quarter);
     
 private:
-    SDL_Texture* texture;
-    SDL_Rect srcRect;
-    
-    static const int SPRITE_SIZE = 16;
-    static const int QUARTER_SIZE = 8;
-    static const int SPRITES_PER_ROW = 16;
-    
-    void setQuarterSrcRect(int spriteId, int quarter);
+    const SpriteAtlas* atlas;
+    int spriteId;
 };
 
 #endif // BORDERSPRITE_HPP
@@ -0,0 +1,67 @@
+#include "InputProvider.hpp"
+#include "Log.hpp"
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+InputState KeyboardInputProvider::poll() {
+    const Uint8* keystate = SDL_GetKeyboardState(NULL);
+    
+    InputState input;
+    if (keystate[SDL_SCANCODE_LEFT] || keystate[SDL_SCANCODE_A]) input.buttons |= InputState::LEFT;
+    if (keystate[SDL_SCANCODE_RIGHT] || keystate[SDL_SCANCODE_D]) input.buttons |= InputState::RIGHT;
+    if (keystate[SDL_SCANCODE_UP] || keystate[SDL_SCANCODE_W]) input.buttons |= InputState::UP;
+    if (keystate[SDL_SCANCODE_DOWN] || keystate[SDL_SCANCODE_S]) input.buttons |= InputState::DOWN;
+    if (keystate[SDL_SCANCODE_SPACE]) input.buttons |= InputState::DIG;
+    return input;
+}
+
+ScriptedInputProvider::ScriptedInputProvider(std::vector<InputState> ticks) 
+    : ticks(std::move(ticks)) {
+}
+
+InputState ScriptedInputProvider::poll() {
+    if (position >= ticks.size()) {
+        return InputState();
+    }
+    return ticks[position++];
+}
+
+bool ScriptedInputProvider::parse(const std::string& script, std::vector<InputState>& ticks) {
+    std::istringstream stream(script);
+    std::string token;
+    
+    while (stream >> token) {
+        InputState input;
+        size_t i = 0;
+        
+        // Button letters
+        for (; i < token.size() && !std::isdigit(static_cast<unsigned char>(token[i])); i++) {
+            switch (std::toupper(static_cast<unsigned char>(token[i]))) {
+                case 'L': input.buttons |= InputState::LEFT; break;
+                case 'R': input.buttons |= InputState::RIGHT; break;
+                case 'U': input.buttons |= InputState::UP; break;
+                case 'D': input.buttons |= InputState::DOWN; break;
+                case 'S': input.buttons |= InputState::DIG; break;
+                case '.': break;
+                default:
+                    LOG_ERROR("Unknown input in script token").field("input", std::string(1, token[i])).field("token", token);
+                    return false;
+            }
+        }
+        
+        // Tick count (defaults to one tick)
+        int count = 1;
+        if (i < token.size()) {
+            count = std::atoi(token.c_str() + i);
+            if (count <= 0) {
+                LOG_ERROR("Invalid tick count in script token").field("token", token);
+                return false;
+            }
+        }
+        
+        ticks.insert(ticks.end(), count, input);
+    }
+    
+    return true;
+}
@@ -0,0 +1,58 @@
+#ifndef INPUTPROVIDER_HPP
+#define INPUTPROVIDER_HPP
+
+#include "../main.hpp"
+#include <string>
+#include <vector>
+
+// Buttons held during one simulation tick
+struct InputState {
+    static constexpr uint8_t LEFT  = 1 << 0;
+    static constexpr uint8_t RIGHT = 1 << 1;
+    static constexpr uint8_t UP    = 1 << 2;
+    static constexpr uint8_t DOWN  = 1 << 3;
+    static constexpr uint8_t DIG   = 1 << 4;
+    static constexpr uint8_t ANY_DIRECTION = LEFT | RIGHT | UP | DOWN;
+    
+    uint8_t buttons = 0;
+    
+    bool isPressed(uint8_t button) const { return (buttons & button) != 0; }
+    bool anyDirection() const { return (buttons & ANY_DIRECTION) != 0; }
+};
+
+// Source of per-tick input for Murphy, so the simulation doesn't depend on SDL's keyboard
+class InputProvider {
+public:
+    virtual ~InputProvider() = default;
+    
+    // Called once per simulation tick
+    virtual InputState poll() = 0;
+};
+
+// Reads the live SDL keyboard state (arrows/WASD plus space to dig)
+class KeyboardInputProvider : public InputProvider {
+public:
+    InputState poll() override;
+};
+
+// Plays back a fixed list of per-tick inputs, then reports no buttons held
+class ScriptedInputProvider : public InputProvider {
+public:
+    ScriptedInputProvider() = default;
+    explicit ScriptedInputProvider(std::vector<InputState> ticks);
+    
+    InputState poll() override;
+    
+    // Parses scripts like "R4 D2 .10 SL1": a run of button letters (L, R, U, D,
+    // S for dig, '.' for nothing) followed by how many ticks to hold them
+    static bool parse(const std::string& script, std::vector<InputState>& ticks);
+    
+    bool isFinished() const { return position >= ticks.size(); }
+    size_t getLength() const { return ticks.size(); }
+    
+private:
+    std::vector<InputState> ticks;
+    size_t position = 0;
+};
+
+#endif // INPUTPROVIDER_HPP
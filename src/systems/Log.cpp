@@ -0,0 +1,172 @@
+#include "Log.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+Logger& Logger::getInstance() {
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger()
+    : slots(new Slot[CAPACITY]),
+      enqueuePos(0),
+      dequeuePos(0),
+      dropped(0),
+      droppedReported(0),
+      origin(Clock::now()),
+      running(true) {
+    for (size_t i = 0; i < CAPACITY; i++) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    writer = std::thread(&Logger::writerLoop, this);
+}
+
+Logger::~Logger() {
+    running.store(false);
+    wake.notify_one();
+    writer.join();
+}
+
+void Logger::push(LogLevel level, const char* text, size_t length) {
+    // Claim a slot (bounded MPMC queue: a slot is free for position p when its
+    // sequence equals p)
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &slots[pos & (CAPACITY - 1)];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // Writer is a full queue behind
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+    
+    slot->level = level;
+    slot->length = static_cast<uint16_t>(std::min(length, MESSAGE_SIZE));
+    slot->timeUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - origin).count();
+    std::memcpy(slot->text, text, slot->length);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    
+    wake.notify_one();
+}
+
+void Logger::flush() {
+    size_t target = enqueuePos.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    wake.notify_one();
+    drained.wait(lock, [&]() { return dequeuePos.load(std::memory_order_acquire) >= target; });
+}
+
+bool Logger::hasPending() const {
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    return slots[pos & (CAPACITY - 1)].sequence.load(std::memory_order_acquire) == pos + 1;
+}
+
+bool Logger::writeNext() {
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    Slot& slot = slots[pos & (CAPACITY - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+        return false;
+    }
+    
+    static const char* const LEVEL_NAMES[] = {"DEBUG", "INFO ", "WARN ", "ERROR"};
+    FILE* out = slot.level >= LogLevel::Warn ? stderr : stdout;
+    std::fprintf(out, "[%10.3f] %s %.*s\n", slot.timeUs / 1000.0, LEVEL_NAMES[static_cast<int>(slot.level)],
+                 static_cast<int>(slot.length), slot.text);
+    
+    // Hand the slot back to producers for the next lap
+    slot.sequence.store(pos + CAPACITY, std::memory_order_release);
+    dequeuePos.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+void Logger::writerLoop() {
+    while (true) {
+        bool wrote = false;
+        while (writeNext()) {
+            wrote = true;
+        }
+        
+        uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+        if (droppedNow != droppedReported) {
+            std::fprintf(stderr, "[log] %llu records dropped, queue full\n",
+                         static_cast<unsigned long long>(droppedNow - droppedReported));
+            droppedReported = droppedNow;
+            wrote = true;
+        }
+        if (wrote) {
+            std::fflush(stdout);
+            std::fflush(stderr);
+        }
+        
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        drained.notify_all();
+        if (!running.load() && !hasPending()) {
+            break;
+        }
+        // Producers notify without the lock, so a wakeup can be missed; the
+        // timeout bounds how long a record can sit in the queue
+        wake.wait_for(lock, std::chrono::milliseconds(100), [this]() { return !running.load() || hasPending(); });
+    }
+}
+
+LogRecord::LogRecord(LogLevel level, const char* message) : level(level), length(0) {
+    append(message, std::strlen(message));
+}
+
+LogRecord& LogRecord::field(const char* key, const char* value) {
+    appendKey(key);
+    append("\"", 1);
+    // Paths and SDL errors can hold quotes, backslashes or line breaks, any of
+    // which would split the field or the line
+    for (const char* c = value; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            char escaped[2] = {'\\', *c};
+            append(escaped, 2);
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            char escaped[8];
+            int size = std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(*c));
+            append(escaped, size);
+        } else {
+            append(c, 1);
+        }
+    }
+    append("\"", 1);
+    return *this;
+}
+
+LogRecord& LogRecord::field(const char* key, double value) {
+    char digits[32];
+    int size = std::snprintf(digits, sizeof(digits), "%g", value);
+    appendKey(key);
+    append(digits, std::min(static_cast<size_t>(size), sizeof(digits) - 1));
+    return *this;
+}
+
+LogRecord& LogRecord::hexField(const char* key, unsigned value) {
+    char digits[16];
+    int size = std::snprintf(digits, sizeof(digits), "0x%x", value);
+    appendKey(key);
+    append(digits, size);
+    return *this;
+}
+
+void LogRecord::appendKey(const char* key) {
+    append(" ", 1);
+    append(key, std::strlen(key));
+    append("=", 1);
+}
+
+void LogRecord::append(const char* data, size_t size) {
+    // Overlong records are truncated
+    size = std::min(size, sizeof(text) - length);
+    std::memcpy(text + length, data, size);
+    length += size;
+}
@@ -0,0 +1,136 @@
+#ifndef LOG_HPP
+#define LOG_HPP
+
+#include "../main.hpp"
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+// Not all caps: DEBUG and ERROR are commonly predefined macros (e.g. by
+// <windows.h> and build systems' debug defines)
+enum class LogLevel {
+    Debug,
+    Info,
+    Warn,
+    Error
+};
+
+// Lowest level compiled in; records below it are removed entirely
+#ifndef SUPAPLEX_LOG_LEVEL
+#define SUPAPLEX_LOG_LEVEL 1
+#endif
+
+// Asynchronous log sink. Any thread can push a formatted record into a
+// bounded lock-free queue; a background writer thread does all of the
+// formatting of timestamps and the stdout/stderr I/O. When the queue is full,
+// records are dropped (and counted) rather than blocking the caller.
+class Logger {
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    static Logger& getInstance();
+    
+    void push(LogLevel level, const char* text, size_t length);
+    
+    // Blocks until every record pushed before the call has been written
+    void flush();
+    
+    uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+    
+    static constexpr size_t CAPACITY = 1024;  // Power of two
+    static constexpr size_t MESSAGE_SIZE = 240;
+    
+private:
+    Logger();
+    ~Logger();
+    
+    struct Slot {
+        std::atomic<size_t> sequence;  // == position + 1 once the record is published
+        LogLevel level;
+        uint16_t length;
+        int64_t timeUs;
+        char text[MESSAGE_SIZE];
+    };
+    
+    void writerLoop();
+    bool writeNext();  // Writes and releases the oldest published record
+    bool hasPending() const;
+    
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<size_t> enqueuePos;
+    alignas(64) std::atomic<size_t> dequeuePos;  // Advanced only by the writer
+    std::atomic<uint64_t> dropped;
+    uint64_t droppedReported;
+    
+    Clock::time_point origin;
+    std::atomic<bool> running;
+    std::mutex wakeMutex;
+    std::condition_variable wake;     // New records for the writer
+    std::condition_variable drained;  // Writer caught up, for flush()
+    std::thread writer;
+};
+
+// One log line: a message followed by key=value fields, formatted into a fixed
+// buffer on the caller's thread and queued when the record goes out of scope.
+// Use through the LOG_* macros:
+//   LOG_INFO("Loaded level").field("level", 3).field("title", title);
+class LogRecord {
+public:
+    LogRecord(LogLevel level, const char* message);
+    ~LogRecord() { Logger::getInstance().push(level, text, length); }
+    
+    LogRecord(const LogRecord&) = delete;
+    LogRecord& operator=(const LogRecord&) = delete;
+    
+    LogRecord& field(const char* key, const char* value);
+    LogRecord& field(const char* key, const std::string& value) { return field(key, value.c_str()); }
+    LogRecord& field(const char* key, double value);
+    
+    LogRecord& field(const char* key, bool value) {
+        appendKey(key);
+        append(value ? "true" : "false", value ? 4 : 5);
+        return *this;
+    }
+    
+    // Any other integer; bool has the overload above, since to_chars rejects it
+    template<typename T, typename = std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>>
+    LogRecord& field(const char* key, T value) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        appendKey(key);
+        append(digits, result.ptr - digits);
+        return *this;
+    }
+    
+    LogRecord& hexField(const char* key, unsigned value);
+    
+private:
+    void appendKey(const char* key);
+    void append(const char* data, size_t size);
+    
+    LogLevel level;
+    size_t length;
+    char text[Logger::MESSAGE_SIZE];
+};
+
+// Lets the macros below be a single expression, so they nest safely in an
+// unbraced if; records under SUPAPLEX_LOG_LEVEL sit behind a constant false
+// and, like their field arguments, are never evaluated
+struct LogVoidify {
+    void operator&(const LogRecord&) const {}
+};
+
+#define LOG_AT(level, message) \
+    (static_cast<int>(level) < SUPAPLEX_LOG_LEVEL) ? (void)0 : LogVoidify() & LogRecord(level, message)
+
+#define LOG_DEBUG(message) LOG_AT(LogLevel::Debug, message)
+#define LOG_INFO(message) LOG_AT(LogLevel::Info, message)
+#define LOG_WARN(message) LOG_AT(LogLevel::Warn, message)
+#define LOG_ERROR(message) LOG_AT(LogLevel::Error, message)
+
+#endif // LOG_HPP
@@ -0,0 +1,120 @@
+#include "Lz4.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+}
+
+std::vector<uint8_t> Lz4::compress(const uint8_t* src, size_t size) {
+    std::vector<uint8_t> out;
+    out.reserve(size + size / 255 + 16);
+    
+    // Last position each 4-byte sequence was seen at, plus one (0 = never)
+    std::vector<uint32_t> table(size_t(1) << HASH_BITS, 0);
+    
+    size_t anchor = 0;  // Start of the pending literal run
+    size_t pos = 0;
+    while (pos + MATCH_SAFE_DISTANCE <= size) {
+        uint32_t sequence = read32(src + pos);
+        uint32_t hash = (sequence * 2654435761u) >> (32 - HASH_BITS);
+        size_t candidate = table[hash];
+        table[hash] = static_cast<uint32_t>(pos + 1);
+        
+        if (candidate == 0 || pos - (candidate - 1) > MAX_OFFSET || read32(src + candidate - 1) != sequence) {
+            pos++;
+            continue;
+        }
+        candidate--;
+        
+        size_t matchEnd = pos + MIN_MATCH;
+        while (matchEnd < size - LAST_LITERALS && src[matchEnd] == src[candidate + (matchEnd - pos)]) {
+            matchEnd++;
+        }
+        
+        size_t literalLength = pos - anchor;
+        size_t matchLength = matchEnd - pos - MIN_MATCH;
+        size_t offset = pos - candidate;
+        
+        out.push_back(static_cast<uint8_t>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchLength, 15)));
+        if (literalLength >= 15) writeLength(out, literalLength - 15);
+        out.insert(out.end(), src + anchor, src + pos);
+        out.push_back(static_cast<uint8_t>(offset & 0xFF));
+        out.push_back(static_cast<uint8_t>(offset >> 8));
+        if (matchLength >= 15) writeLength(out, matchLength - 15);
+        
+        pos = matchEnd;
+        anchor = pos;
+    }
+    
+    // Trailing literals
+    size_t literalLength = size - anchor;
+    out.push_back(static_cast<uint8_t>(std::min<size_t>(literalLength, 15) << 4));
+    if (literalLength >= 15) writeLength(out, literalLength - 15);
+    out.insert(out.end(), src + anchor, src + size);
+    
+    return out;
+}
+
+bool Lz4::decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    size_t in = 0;
+    size_t out = 0;
+    while (in < srcSize) {
+        uint8_t token = src[in++];
+        
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(src, srcSize, in, literalLength)) return false;
+        if (literalLength > srcSize - in || literalLength > dstSize - out) return false;
+        std::memcpy(dst + out, src + in, literalLength);
+        in += literalLength;
+        out += literalLength;
+        
+        // The last sequence has no match part
+        if (in == srcSize) break;
+        
+        if (srcSize - in < 2) return false;
+        size_t offset = src[in] | (src[in + 1] << 8);
+        in += 2;
+        if (offset == 0 || offset > out) return false;
+        
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(src, srcSize, in, matchLength)) return false;
+        matchLength += MIN_MATCH;
+        if (matchLength > dstSize - out) return false;
+        
+        // Matches may overlap their own output (runs), which memcpy can't do
+        if (offset >= matchLength) {
+            std::memcpy(dst + out, dst + out - offset, matchLength);
+        } else {
+            for (size_t i = 0; i < matchLength; i++) {
+                dst[out + i] = dst[out + i - offset];
+            }
+        }
+        out += matchLength;
+    }
+    return out == dstSize;
+}
+
+void Lz4::writeLength(std::vector<uint8_t>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+bool Lz4::readLength(const uint8_t* src, size_t srcSize, size_t& pos, size_t& length) {
+    uint8_t byte;
+    do {
+        if (pos >= srcSize) return false;
+        byte = src[pos++];
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
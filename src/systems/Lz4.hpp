@@ -0,0 +1,28 @@
+#ifndef LZ4_HPP
+#define LZ4_HPP
+
+#include "../main.hpp"
+#include <vector>
+
+// Minimal LZ4 block format codec (no frame header), enough for asset bundles.
+// Output is readable by the reference LZ4_decompress_safe.
+class Lz4 {
+public:
+    static std::vector<uint8_t> compress(const uint8_t* src, size_t size);
+    
+    // dstSize must be the exact uncompressed size; fails on malformed input
+    // instead of reading or writing out of bounds
+    static bool decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+    
+private:
+    static const int HASH_BITS = 16;
+    static const size_t MIN_MATCH = 4;
+    static const size_t MAX_OFFSET = 65535;
+    static const size_t MATCH_SAFE_DISTANCE = 12;  // No match may start closer to the end
+    static const size_t LAST_LITERALS = 5;         // The block always ends in literals
+    
+    static void writeLength(std::vector<uint8_t>& out, size_t length);
+    static bool readLength(const uint8_t* src, size_t srcSize, size_t& pos, size_t& length);
+};
+
+#endif // LZ4_HPP
@@ -0,0 +1,109 @@
+#include "MappedFile.hpp"
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() 
+    : mappedData(nullptr), mappedSize(0), isMapped(false)
+#ifdef _WIN32
+    , fileHandle(nullptr), mappingHandle(nullptr)
+#endif
+{
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (view) {
+                    fileHandle = file;
+                    mappingHandle = mapping;
+                    mappedData = static_cast<const uint8_t*>(view);
+                    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+                    isMapped = true;
+                    return true;
+                }
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+            void* view = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED) {
+                // The mapping stays valid after the descriptor is closed
+                ::close(fd);
+                mappedData = static_cast<const uint8_t*>(view);
+                mappedSize = static_cast<size_t>(fileStat.st_size);
+                isMapped = true;
+                return true;
+            }
+        }
+        ::close(fd);
+    }
+#endif
+    
+    // Fall back to a plain read
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    file.seekg(0, std::ios::end);
+    size_t fileSize = file.tellg();
+    file.seekg(0, std::ios::beg);
+    if (fileSize == 0) {
+        return false;
+    }
+    
+    fallbackBuffer.resize(fileSize);
+    file.read(reinterpret_cast<char*>(fallbackBuffer.data()), fileSize);
+    
+    mappedData = fallbackBuffer.data();
+    mappedSize = fileSize;
+    isMapped = false;
+    return true;
+}
+
+void MappedFile::close() {
+    if (isMapped && mappedData) {
+#ifdef _WIN32
+        UnmapViewOfFile(mappedData);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(mappedData), mappedSize);
+#endif
+    }
+    
+    fallbackBuffer.clear();
+    fallbackBuffer.shrink_to_fit();
+    mappedData = nullptr;
+    mappedSize = 0;
+    isMapped = false;
+}
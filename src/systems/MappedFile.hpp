@@ -0,0 +1,37 @@
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include "../main.hpp"
+#include <string>
+#include <vector>
+
+// Read-only memory mapping of a whole file. Falls back to reading the file
+// into memory on platforms without mmap/MapViewOfFile.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    bool open(const std::string& path);
+    void close();
+    
+    bool isOpen() const { return mappedData != nullptr; }
+    const uint8_t* data() const { return mappedData; }
+    size_t size() const { return mappedSize; }
+    
+private:
+    const uint8_t* mappedData;
+    size_t mappedSize;
+    bool isMapped;  // false when data lives in fallbackBuffer
+    std::vector<uint8_t> fallbackBuffer;
+    
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+#endif // MAPPEDFILE_HPP
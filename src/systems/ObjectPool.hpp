@@ -0,0 +1,105 @@
+#ifndef OBJECTPOOL_HPP
+#define OBJECTPOOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Typed pool with stable addresses. Storage comes in large chunks that are
+// kept across reset(), so reloading a level of similar size allocates nothing;
+// destroyed objects go on a free list and their slots are reused.
+template <typename T>
+class ObjectPool {
+public:
+    ObjectPool() : currentChunk(0), currentIndex(0), liveCount(0) {}
+    
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+    
+    // Make sure `count` more objects fit without further allocation
+    void reserve(size_t count) {
+        size_t available = freeList.size();
+        for (size_t i = currentChunk; i < chunks.size(); i++) {
+            available += chunks[i].size - (i == currentChunk ? currentIndex : 0);
+        }
+        if (available < count) {
+            addChunk(count - available);
+        }
+    }
+    
+    template <typename... Args>
+    T* create(Args&&... args) {
+        void* slot;
+        if (!freeList.empty()) {
+            slot = freeList.back();
+            freeList.pop_back();
+        } else {
+            while (currentChunk < chunks.size() && currentIndex == chunks[currentChunk].size) {
+                currentChunk++;
+                currentIndex = 0;
+            }
+            if (currentChunk == chunks.size()) {
+                addChunk(capacity() > MIN_CHUNK_SIZE ? capacity() : MIN_CHUNK_SIZE);
+            }
+            slot = &chunks[currentChunk].slots[currentIndex++];
+        }
+        
+        liveCount++;
+        return new (slot) T(std::forward<Args>(args)...);
+    }
+    
+    void destroy(T* object) {
+        if (!object) return;
+        
+        object->~T();
+        freeList.push_back(object);
+        liveCount--;
+    }
+    
+    // Forget every slot while keeping the memory. All objects must already be destroyed.
+    void reset() {
+        currentChunk = 0;
+        currentIndex = 0;
+        freeList.clear();
+        liveCount = 0;
+    }
+    
+    size_t capacity() const {
+        size_t total = 0;
+        for (const Chunk& chunk : chunks) {
+            total += chunk.size;
+        }
+        return total;
+    }
+    
+    size_t getLiveCount() const { return liveCount; }
+    
+private:
+    struct alignas(T) Slot {
+        unsigned char bytes[sizeof(T)];
+    };
+    
+    struct Chunk {
+        std::unique_ptr<Slot[]> slots;
+        size_t size;
+    };
+    
+    void addChunk(size_t size) {
+        chunks.push_back({std::unique_ptr<Slot[]>(new Slot[size]), size});
+        
+        // Every slot can end up on the free list; size it now so destroy() never allocates
+        freeList.reserve(capacity());
+    }
+    
+    std::vector<Chunk> chunks;
+    size_t currentChunk;   // Bump allocation position
+    size_t currentIndex;
+    std::vector<void*> freeList;
+    size_t liveCount;
+    
+    static constexpr size_t MIN_CHUNK_SIZE = 64;
+};
+
+#endif // OBJECTPOOL_HPP
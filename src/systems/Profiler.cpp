@@ -0,0 +1,149 @@
+#include "Profiler.hpp"
+#include "AllocationCounter.hpp"
+#include "Log.hpp"
+#include <algorithm>
+#include <fstream>
+
+Profiler& Profiler::getInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() 
+    : current(), history(), historyIndex(0), historyCount(0), frameStart(Clock::now()),
+      frameAllocationBase(0), overlayVisible(false), tracing(false) {
+}
+
+void Profiler::setRecordingThread() {
+    recordingThread = true;
+}
+
+void Profiler::beginFrame() {
+    current = ProfileFrame();
+    frameStart = Clock::now();
+    frameAllocationBase = AllocationCounter::getCount();
+}
+
+void Profiler::endFrame() {
+    addSample(ProfileSection::FRAME, frameStart, Clock::now());
+    current.counters[static_cast<size_t>(ProfileCounter::HEAP_ALLOCATIONS)] =
+        static_cast<uint32_t>(AllocationCounter::getCount() - frameAllocationBase);
+    
+    history[historyIndex] = current;
+    historyIndex = (historyIndex + 1) % HISTORY_SIZE;
+    historyCount = std::min(historyCount + 1, HISTORY_SIZE);
+}
+
+void Profiler::addSample(ProfileSection section, Clock::time_point start, Clock::time_point end) {
+    if (!recordingThread) return;
+    
+    current.sectionMs[static_cast<size_t>(section)] += std::chrono::duration<double, std::milli>(end - start).count();
+    
+    if (tracing && traceEvents.size() < MAX_TRACE_EVENTS) {
+        TraceEvent event;
+        event.section = section;
+        event.startUs = std::chrono::duration_cast<std::chrono::microseconds>(start - traceStart).count();
+        event.durationUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        traceEvents.push_back(event);
+    }
+}
+
+const ProfileFrame& Profiler::getLastFrame() const {
+    int last = (historyIndex + HISTORY_SIZE - 1) % HISTORY_SIZE;
+    return history[last];
+}
+
+int Profiler::getAllocatingFrameCount() const {
+    int frames = 0;
+    for (int i = 0; i < historyCount; i++) {
+        if (history[i].counters[static_cast<size_t>(ProfileCounter::HEAP_ALLOCATIONS)] > 0) {
+            frames++;
+        }
+    }
+    return frames;
+}
+
+bool Profiler::writeCsv(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open profile output").field("path", path);
+        return false;
+    }
+    
+    file << "frame";
+    for (size_t i = 0; i < static_cast<size_t>(ProfileSection::COUNT); i++) {
+        file << "," << getSectionName(static_cast<ProfileSection>(i)) << "_ms";
+    }
+    for (size_t i = 0; i < static_cast<size_t>(ProfileCounter::COUNT); i++) {
+        file << "," << getCounterName(static_cast<ProfileCounter>(i));
+    }
+    file << "\n";
+    
+    for (int i = 0; i < historyCount; i++) {
+        const ProfileFrame& frame = history[(historyIndex - historyCount + i + HISTORY_SIZE) % HISTORY_SIZE];
+        file << i;
+        for (double ms : frame.sectionMs) {
+            file << "," << ms;
+        }
+        for (uint32_t value : frame.counters) {
+            file << "," << value;
+        }
+        file << "\n";
+    }
+    
+    LOG_INFO("Wrote profile data").field("frames", historyCount).field("path", path);
+    return true;
+}
+
+void Profiler::startTrace() {
+    traceEvents.clear();
+    traceStart = Clock::now();
+    tracing = true;
+}
+
+bool Profiler::stopTrace(const std::string& path) {
+    tracing = false;
+    
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open trace output").field("path", path);
+        return false;
+    }
+    
+    // Chrome trace event format, loadable in chrome://tracing or Perfetto
+    file << "{\"traceEvents\":[\n";
+    for (size_t i = 0; i < traceEvents.size(); i++) {
+        const TraceEvent& event = traceEvents[i];
+        file << "{\"name\":\"" << getSectionName(event.section) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+             << ",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs << "}";
+        file << (i + 1 < traceEvents.size() ? ",\n" : "\n");
+    }
+    file << "]}\n";
+    
+    LOG_INFO("Wrote trace").field("events", traceEvents.size()).field("path", path);
+    traceEvents.clear();
+    return true;
+}
+
+const char* Profiler::getSectionName(ProfileSection section) {
+    switch (section) {
+        case ProfileSection::FRAME: return "frame";
+        case ProfileSection::LEVEL_UPDATE: return "level_update";
+        case ProfileSection::GRAVITY: return "gravity";
+        case ProfileSection::RENDER_REGION: return "render_region";
+        case ProfileSection::RENDER_BORDERS: return "render_borders";
+        case ProfileSection::RENDER_PANEL: return "render_panel";
+        case ProfileSection::PRESENT: return "present";
+        default: return "unknown";
+    }
+}
+
+const char* Profiler::getCounterName(ProfileCounter counter) {
+    switch (counter) {
+        case ProfileCounter::DRAW_CALLS: return "draw_calls";
+        case ProfileCounter::GET_OBJECT_AT: return "get_object_at";
+        case ProfileCounter::OBJECTS_UPDATED: return "objects_updated";
+        case ProfileCounter::HEAP_ALLOCATIONS: return "heap_allocations";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,133 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include "../main.hpp"
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Timed parts of a frame
+enum class ProfileSection {
+    FRAME,
+    LEVEL_UPDATE,
+    GRAVITY,
+    RENDER_REGION,
+    RENDER_BORDERS,
+    RENDER_PANEL,
+    PRESENT,
+    COUNT
+};
+
+// Per-frame event counters
+enum class ProfileCounter {
+    DRAW_CALLS,
+    GET_OBJECT_AT,
+    OBJECTS_UPDATED,
+    HEAP_ALLOCATIONS,  // Only counted in builds with SUPAPLEX_COUNT_ALLOCATIONS
+    COUNT
+};
+
+struct ProfileFrame {
+    std::array<double, static_cast<size_t>(ProfileSection::COUNT)> sectionMs;
+    std::array<uint32_t, static_cast<size_t>(ProfileCounter::COUNT)> counters;
+};
+
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    static Profiler& getInstance();
+    
+    // Makes the calling thread the one that records; call once, from the game
+    // loop's thread. Samples and counts from any other thread (e.g. batch
+    // validator workers) are dropped, and nothing is recorded until then.
+    void setRecordingThread();
+    
+    void beginFrame();
+    void endFrame();
+    
+    void addSample(ProfileSection section, Clock::time_point start, Clock::time_point end);
+    void count(ProfileCounter counter, uint32_t amount = 1) {
+        if (!recordingThread) return;
+        current.counters[static_cast<size_t>(counter)] += amount;
+    }
+    
+    // Most recently completed frame
+    const ProfileFrame& getLastFrame() const;
+    
+    // Frames in the history that touched the heap; zero in a steady game loop
+    int getAllocatingFrameCount() const;
+    int getHistoryCount() const { return historyCount; }
+    
+    // Overlay
+    void toggleOverlay() { overlayVisible = !overlayVisible; }
+    bool isOverlayVisible() const { return overlayVisible; }
+    void renderOverlay(SDL_Renderer* renderer, int x, int y, int width, int height) const;
+    
+    // Offline analysis: CSV of the frame history, Chrome trace of a capture
+    bool writeCsv(const std::string& path) const;
+    void startTrace();
+    bool stopTrace(const std::string& path);
+    bool isTracing() const { return tracing; }
+    
+    static const char* getSectionName(ProfileSection section);
+    static const char* getCounterName(ProfileCounter counter);
+    
+    static constexpr int HISTORY_SIZE = 300;
+    
+private:
+    Profiler();
+    
+    // Set on the bound thread only; a plain flag so the hot-path check
+    // doesn't have to look up the thread id
+    static inline thread_local bool recordingThread = false;
+    
+    struct TraceEvent {
+        ProfileSection section;
+        int64_t startUs;
+        int64_t durationUs;
+    };
+    
+    ProfileFrame current;
+    std::array<ProfileFrame, HISTORY_SIZE> history;
+    int historyIndex;   // Next slot to write
+    int historyCount;
+    Clock::time_point frameStart;
+    uint64_t frameAllocationBase;
+    
+    bool overlayVisible;
+    bool tracing;
+    Clock::time_point traceStart;
+    std::vector<TraceEvent> traceEvents;
+    
+    static constexpr size_t MAX_TRACE_EVENTS = 1000000;
+};
+
+// Adds the time spent in the enclosing scope to a section of the current frame
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileSection section) : section(section), start(Profiler::Clock::now()) {}
+    ~ProfileScope() { Profiler::getInstance().addSample(section, start, Profiler::Clock::now()); }
+    
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+    
+private:
+    ProfileSection section;
+    Profiler::Clock::time_point start;
+};
+
+// Instrumentation compiles away unless SUPAPLEX_PROFILER is defined
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef SUPAPLEX_PROFILER
+#define PROFILE_SCOPE(section) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(ProfileSection::section)
+#define PROFILE_COUNT(counter, amount) Profiler::getInstance().count(ProfileCounter::counter, amount)
+#else
+#define PROFILE_SCOPE(section) ((void)0)
+#define PROFILE_COUNT(counter, amount) ((void)0)
+#endif
+
+#endif // PROFILER_HPP
@@ -0,0 +1,87 @@
+// The F1 overlay is drawing code, so it lives in the render library with the
+// rest of the video side; the simulation core only records samples.
+#include "Profiler.hpp"
+#include <algorithm>
+
+namespace {
+
+const SDL_Color SECTION_COLORS[] = {
+    {0x80, 0x80, 0x80, 0xFF},  // FRAME
+    {0x40, 0xC0, 0x40, 0xFF},  // LEVEL_UPDATE
+    {0xC0, 0xC0, 0x40, 0xFF},  // GRAVITY
+    {0x40, 0x80, 0xE0, 0xFF},  // RENDER_REGION
+    {0x80, 0x40, 0xE0, 0xFF},  // RENDER_BORDERS
+    {0xE0, 0x80, 0x40, 0xFF},  // RENDER_PANEL
+    {0xE0, 0x40, 0x40, 0xFF},  // PRESENT
+};
+
+// Sections are timed inside the one they're nested in; FRAME is the root
+const ProfileSection SECTION_PARENTS[] = {
+    ProfileSection::COUNT,          // FRAME
+    ProfileSection::FRAME,          // LEVEL_UPDATE
+    ProfileSection::LEVEL_UPDATE,   // GRAVITY
+    ProfileSection::FRAME,          // RENDER_REGION
+    ProfileSection::RENDER_REGION,  // RENDER_BORDERS
+    ProfileSection::FRAME,          // RENDER_PANEL
+    ProfileSection::FRAME,          // PRESENT
+};
+static_assert(sizeof(SECTION_PARENTS) / sizeof(SECTION_PARENTS[0]) == static_cast<size_t>(ProfileSection::COUNT),
+              "One parent per ProfileSection");
+
+}
+
+void Profiler::renderOverlay(SDL_Renderer* renderer, int x, int y, int width, int height) const {
+    if (!overlayVisible || !renderer) return;
+    
+    const double budgetMs = 1000.0 / 60.0;  // Full height/width is one 60 Hz frame
+    
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xC0);
+    SDL_Rect background = {x, y, width, height};
+    SDL_RenderFillRect(renderer, &background);
+    
+    // Frame time graph, oldest on the left
+    int graphHeight = height - 6;
+    int bars = std::min(historyCount, width);
+    for (int i = 0; i < bars; i++) {
+        int slot = (historyIndex - bars + i + HISTORY_SIZE) % HISTORY_SIZE;
+        double frameMs = history[slot].sectionMs[static_cast<size_t>(ProfileSection::FRAME)];
+        int barHeight = std::min(graphHeight, static_cast<int>(frameMs / budgetMs * graphHeight));
+        bool allocated = history[slot].counters[static_cast<size_t>(ProfileCounter::HEAP_ALLOCATIONS)] > 0;
+        
+        if (frameMs > budgetMs) {
+            SDL_SetRenderDrawColor(renderer, 0xE0, 0x40, 0x40, 0xFF);
+        } else if (allocated) {
+            SDL_SetRenderDrawColor(renderer, 0xE0, 0xE0, 0x40, 0xFF);
+        } else {
+            SDL_SetRenderDrawColor(renderer, 0x40, 0xC0, 0x40, 0xFF);
+        }
+        SDL_RenderDrawLine(renderer, x + width - bars + i, y + graphHeight,
+                           x + width - bars + i, y + graphHeight - barHeight);
+    }
+    
+    // Last frame split by section along the bottom edge. Nested sections are
+    // subtracted from their parent so each millisecond is drawn once; children
+    // follow their parent in enum order, so they sit right after its own time.
+    const ProfileFrame& last = getLastFrame();
+    std::array<double, static_cast<size_t>(ProfileSection::COUNT)> selfMs = last.sectionMs;
+    for (size_t i = 1; i < selfMs.size(); i++) {
+        size_t parent = static_cast<size_t>(SECTION_PARENTS[i]);
+        selfMs[parent] = std::max(0.0, selfMs[parent] - last.sectionMs[i]);
+    }
+    
+    int barX = x;
+    for (size_t i = 1; i < selfMs.size(); i++) {
+        int barWidth = static_cast<int>(selfMs[i] / budgetMs * width);
+        if (barWidth <= 0) continue;
+        
+        const SDL_Color& color = SECTION_COLORS[i];
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+        SDL_Rect sectionRect = {barX, y + height - 5, std::min(barWidth, x + width - barX), 4};
+        SDL_RenderFillRect(renderer, &sectionRect);
+        barX += barWidth;
+        if (barX >= x + width) break;
+    }
+    
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
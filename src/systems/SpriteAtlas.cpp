@@ -0,0 +1,53 @@
+#include "SpriteAtlas.hpp"
+
+SpriteAtlas::SpriteAtlas() : texture(nullptr), spriteCount(0) {
+}
+
+void SpriteAtlas::build(SDL_Texture* texture) {
+    clear();
+    
+    int height = 0;
+    if (!texture || SDL_QueryTexture(texture, nullptr, nullptr, nullptr, &height) != 0) {
+        return;
+    }
+    build(texture, gridRects(height));
+}
+
+void SpriteAtlas::build(SDL_Texture* texture, const std::vector<SDL_Rect>& rects) {
+    clear();
+    if (!texture) {
+        return;
+    }
+    
+    this->texture = texture;
+    spriteCount = static_cast<int>(rects.size());
+    spriteRects = rects;
+    quarterRects.resize(spriteCount * 4);
+    
+    for (int spriteId = 0; spriteId < spriteCount; spriteId++) {
+        int baseX = rects[spriteId].x;
+        int baseY = rects[spriteId].y;
+        
+        SDL_Rect* quarters = &quarterRects[spriteId * 4];
+        quarters[0] = {baseX + QUARTER_SIZE, baseY + QUARTER_SIZE, QUARTER_SIZE, QUARTER_SIZE};  // Bottom right
+        quarters[1] = {baseX, baseY + QUARTER_SIZE, QUARTER_SIZE, QUARTER_SIZE};                 // Bottom left
+        quarters[2] = {baseX + QUARTER_SIZE, baseY, QUARTER_SIZE, QUARTER_SIZE};                 // Upper right
+        quarters[3] = {baseX, baseY, QUARTER_SIZE, QUARTER_SIZE};                                // Upper left
+    }
+}
+
+std::vector<SDL_Rect> SpriteAtlas::gridRects(int sheetHeight) {
+    std::vector<SDL_Rect> rects((sheetHeight / SPRITE_SIZE) * SPRITES_PER_ROW);
+    for (int spriteId = 0; spriteId < static_cast<int>(rects.size()); spriteId++) {
+        rects[spriteId] = {(spriteId % SPRITES_PER_ROW) * SPRITE_SIZE, (spriteId / SPRITES_PER_ROW) * SPRITE_SIZE,
+                           SPRITE_SIZE, SPRITE_SIZE};
+    }
+    return rects;
+}
+
+void SpriteAtlas::clear() {
+    texture = nullptr;
+    spriteCount = 0;
+    spriteRects.clear();
+    quarterRects.clear();
+}
@@ -0,0 +1,45 @@
+#ifndef SPRITEATLAS_HPP
+#define SPRITEATLAS_HPP
+
+#include "../main.hpp"
+#include <vector>
+
+// Source rectangles for every 16x16 sprite id in the sprite sheet, plus the
+// four 8x8 quarters the level borders use, computed once when the sheet is
+// loaded. Sprites refer to it by id, so drawing is a table lookup.
+class SpriteAtlas {
+public:
+    SpriteAtlas();
+    
+    void build(SDL_Texture* texture);
+    // Uses a precomputed sprite table (e.g. from an asset bundle) instead of
+    // deriving the layout from the texture size
+    void build(SDL_Texture* texture, const std::vector<SDL_Rect>& rects);
+    void clear();
+    
+    bool isLoaded() const { return texture != nullptr; }
+    SDL_Texture* getTexture() const { return texture; }
+    int getSpriteCount() const { return spriteCount; }
+    bool isValid(int spriteId) const { return spriteId >= 0 && spriteId < spriteCount; }
+    
+    // Callers check isValid first
+    const SDL_Rect& getSpriteRect(int spriteId) const { return spriteRects[spriteId]; }
+    const SDL_Rect& getQuarterRect(int spriteId, int quarter) const {
+        return quarterRects[spriteId * 4 + (quarter >= 0 && quarter < 4 ? quarter : 3)];
+    }
+    
+    // Sprite rects of a sheet laid out as SPRITES_PER_ROW columns of SPRITE_SIZE cells
+    static std::vector<SDL_Rect> gridRects(int sheetHeight);
+    
+    static const int SPRITE_SIZE = 16;
+    static const int QUARTER_SIZE = 8;
+    static const int SPRITES_PER_ROW = 16;
+    
+private:
+    SDL_Texture* texture;
+    int spriteCount;
+    std::vector<SDL_Rect> spriteRects;
+    std::vector<SDL_Rect> quarterRects;  // 4 per sprite: bottom right, bottom left, upper right, upper left
+};
+
+#endif // SPRITEATLAS_HPP
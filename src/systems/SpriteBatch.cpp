@@ -0,0 +1,78 @@
+#include "SpriteBatch.hpp"
+
+SpriteBatch::SpriteBatch() 
+    : renderer(nullptr), texture(nullptr), invTextureWidth(0.0f), invTextureHeight(0.0f),
+      submitCount(0) {
+}
+
+void SpriteBatch::draw(SDL_Texture* texture, const SDL_Rect& srcRect, const SDL_Rect& dstRect) {
+    if (!renderer || !texture) return;
+    
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (texture != this->texture) {
+        flush();
+        this->texture = texture;
+        
+        int width = 0, height = 0;
+        SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+        invTextureWidth = width > 0 ? 1.0f / width : 0.0f;
+        invTextureHeight = height > 0 ? 1.0f / height : 0.0f;
+    }
+    
+    float u0 = srcRect.x * invTextureWidth;
+    float v0 = srcRect.y * invTextureHeight;
+    float u1 = (srcRect.x + srcRect.w) * invTextureWidth;
+    float v1 = (srcRect.y + srcRect.h) * invTextureHeight;
+    
+    float x0 = static_cast<float>(dstRect.x);
+    float y0 = static_cast<float>(dstRect.y);
+    float x1 = static_cast<float>(dstRect.x + dstRect.w);
+    float y1 = static_cast<float>(dstRect.y + dstRect.h);
+    
+    const SDL_Color white = {0xFF, 0xFF, 0xFF, 0xFF};
+    int base = static_cast<int>(vertices.size());
+    
+    vertices.push_back({{x0, y0}, white, {u0, v0}});
+    vertices.push_back({{x1, y0}, white, {u1, v0}});
+    vertices.push_back({{x1, y1}, white, {u1, v1}});
+    vertices.push_back({{x0, y1}, white, {u0, v1}});
+    
+    // Two triangles per quad
+    indices.push_back(base);
+    indices.push_back(base + 1);
+    indices.push_back(base + 2);
+    indices.push_back(base);
+    indices.push_back(base + 2);
+    indices.push_back(base + 3);
+#else
+    // No geometry API before SDL 2.0.18, draw immediately
+    SDL_RenderCopy(renderer, texture, &srcRect, &dstRect);
+    submitCount++;
+#endif
+}
+
+void SpriteBatch::flush() {
+    if (!vertices.empty()) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        SDL_RenderGeometry(renderer, texture,
+                           vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size()));
+        submitCount++;
+#endif
+        
+        vertices.clear();
+        indices.clear();
+    }
+    
+    // Forget the texture and its UV scale: between batches it may be destroyed
+    // and a new texture of another size can get the same address
+    texture = nullptr;
+    invTextureWidth = 0.0f;
+    invTextureHeight = 0.0f;
+}
+
+int SpriteBatch::takeSubmitCount() {
+    int count = submitCount;
+    submitCount = 0;
+    return count;
+}
@@ -0,0 +1,37 @@
+#ifndef SPRITEBATCH_HPP
+#define SPRITEBATCH_HPP
+
+#include "../main.hpp"
+#include <vector>
+
+// Collects textured quads and submits them with a single SDL_RenderGeometry
+// call per texture, instead of one SDL_RenderCopy per tile.
+class SpriteBatch {
+public:
+    SpriteBatch();
+    
+    void setRenderer(SDL_Renderer* renderer) { this->renderer = renderer; }
+    SDL_Renderer* getRenderer() const { return renderer; }
+    
+    // Queue a quad; switching texture flushes what's queued so far
+    void draw(SDL_Texture* texture, const SDL_Rect& srcRect, const SDL_Rect& dstRect);
+    
+    // Submit all queued quads. Textures drawn before a flush may be destroyed after it.
+    void flush();
+    
+    // Submissions made since the last call, for profiling
+    int takeSubmitCount();
+    
+private:
+    SDL_Renderer* renderer;
+    SDL_Texture* texture;  // Of the queued quads; reset by flush()
+    float invTextureWidth, invTextureHeight;
+    
+    // Reused between frames so batching doesn't allocate in steady state
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    
+    int submitCount;
+};
+
+#endif // SPRITEBATCH_HPP
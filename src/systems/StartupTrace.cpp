@@ -0,0 +1,94 @@
+#include "StartupTrace.hpp"
+#include "Log.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+
+// Phase names can hold paths, and Windows paths have backslashes
+void writeJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                << std::dec << std::setfill(' ');
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+}
+
+StartupTrace& StartupTrace::getInstance() {
+    static StartupTrace instance;
+    return instance;
+}
+
+StartupTrace::StartupTrace() : origin(Clock::now()) {
+    threads.push_back(std::this_thread::get_id());
+}
+
+void StartupTrace::record(const std::string& phase, Clock::time_point start, Clock::time_point end) {
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    std::thread::id id = std::this_thread::get_id();
+    auto it = std::find(threads.begin(), threads.end(), id);
+    int thread = static_cast<int>(it - threads.begin());
+    if (it == threads.end()) {
+        threads.push_back(id);
+    }
+    
+    Phase entry;
+    entry.name = phase;
+    entry.thread = thread;
+    entry.startMs = std::chrono::duration<double, std::milli>(start - origin).count();
+    entry.durationMs = std::chrono::duration<double, std::milli>(end - start).count();
+    phases.push_back(entry);
+}
+
+void StartupTrace::printReport() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    std::vector<Phase> sorted = phases;
+    std::sort(sorted.begin(), sorted.end(), [](const Phase& a, const Phase& b) { return a.startMs < b.startMs; });
+    
+    double endMs = 0.0;
+    std::cout << "Startup phases (ms):" << std::endl;
+    for (const Phase& phase : sorted) {
+        std::cout << "  " << std::fixed << std::setprecision(2) << std::setw(8) << phase.startMs
+                  << " +" << std::setw(7) << phase.durationMs << "  "
+                  << (phase.thread == 0 ? "main    " : "worker " + std::to_string(phase.thread)) << "  "
+                  << phase.name << std::endl;
+        endMs = std::max(endMs, phase.startMs + phase.durationMs);
+    }
+    std::cout << "  Startup took " << endMs << " ms" << std::defaultfloat << std::endl;
+}
+
+bool StartupTrace::writeChromeTrace(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open trace output").field("path", path);
+        return false;
+    }
+    
+    // Same format as the profiler's F3 capture
+    file << "{\"traceEvents\":[\n";
+    for (size_t i = 0; i < phases.size(); i++) {
+        const Phase& phase = phases[i];
+        file << "{\"name\":";
+        writeJsonString(file, phase.name);
+        file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << phase.thread + 1
+             << ",\"ts\":" << static_cast<int64_t>(phase.startMs * 1000.0)
+             << ",\"dur\":" << static_cast<int64_t>(phase.durationMs * 1000.0) << "}";
+        file << (i + 1 < phases.size() ? ",\n" : "\n");
+    }
+    file << "]}\n";
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef STARTUPTRACE_HPP
+#define STARTUPTRACE_HPP
+
+#include "../main.hpp"
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Records how long each startup phase took and on which thread, so the
+// loading pipeline can be checked for what actually overlaps
+class StartupTrace {
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    static StartupTrace& getInstance();
+    
+    // Thread-safe; times are relative to the first call to getInstance()
+    void record(const std::string& phase, Clock::time_point start, Clock::time_point end);
+    
+    // Per-phase table on stdout, plus a Chrome trace with one lane per thread
+    void printReport() const;
+    bool writeChromeTrace(const std::string& path) const;
+    
+private:
+    StartupTrace();
+    
+    struct Phase {
+        std::string name;
+        int thread;  // 0 is the main thread, workers are numbered as they show up
+        double startMs;
+        double durationMs;
+    };
+    
+    mutable std::mutex mutex;
+    Clock::time_point origin;
+    std::vector<std::thread::id> threads;
+    std::vector<Phase> phases;
+};
+
+// Records the enclosing scope as one startup phase
+class StartupPhase {
+public:
+    explicit StartupPhase(const std::string& name) : name(name), start(StartupTrace::Clock::now()) {}
+    ~StartupPhase() { StartupTrace::getInstance().record(name, start, StartupTrace::Clock::now()); }
+    
+    StartupPhase(const StartupPhase&) = delete;
+    StartupPhase& operator=(const StartupPhase&) = delete;
+    
+private:
+    std::string name;
+    StartupTrace::Clock::time_point start;
+};
+
+#endif // STARTUPTRACE_HPP
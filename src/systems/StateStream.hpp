@@ -0,0 +1,53 @@
+#ifndef STATESTREAM_HPP
+#define STATESTREAM_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Minimal binary writer/reader for snapshots. Values are copied as raw bytes,
+// so snapshots are only meant to be read back by the same build.
+class StateWriter {
+public:
+    explicit StateWriter(std::vector<uint8_t>& buffer) : buffer(buffer) {}
+    
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "StateWriter only writes plain values");
+        size_t offset = buffer.size();
+        buffer.resize(offset + sizeof(T));
+        std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+    
+private:
+    std::vector<uint8_t>& buffer;
+};
+
+class StateReader {
+public:
+    StateReader(const uint8_t* data, size_t size) : data(data), size(size), position(0), failed(false) {}
+    
+    template <typename T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "StateReader only reads plain values");
+        if (failed || size - position < sizeof(T)) {
+            failed = true;
+            return false;
+        }
+        std::memcpy(&value, data + position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+    
+    bool ok() const { return !failed; }
+    bool atEnd() const { return position == size; }
+    
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+    bool failed;
+};
+
+#endif // STATESTREAM_HPP
@@ -0,0 +1,304 @@
+// Microbenchmarks for the Level hot paths. Each benchmark is calibrated to run
+// for at least --min-time per repetition; results are printed and written to
+// JSON so runs can be compared between releases.
+#include "../main.hpp"
+#include "../game/Level.hpp"
+#include "../game/LevelLoader.hpp"
+#include "../systems/AssetManager.hpp"
+#include "../systems/Log.hpp"
+#include "../systems/SpriteBatch.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations;   // Per repetition
+    double nsPerOp;        // Median over repetitions
+    double minNsPerOp;
+};
+
+// Keeps results of benchmarked calls alive so the optimizer can't drop them
+volatile uintptr_t benchSink;
+
+constexpr int REPETITIONS = 5;
+
+class BenchRunner {
+public:
+    BenchRunner(const std::string& filter, double minTimeMs) : filter(filter), minTimeMs(minTimeMs) {}
+
+    // `body` performs the measured operation `iterations` times
+    void run(const std::string& name, const std::function<void(uint64_t)>& body) {
+        if (!filter.empty() && name.find(filter) == std::string::npos) return;
+
+        // Grow the batch until one repetition takes long enough to time reliably
+        uint64_t iterations = 1;
+        while (true) {
+            double ms = timeBatch(body, iterations) / 1e6;
+            if (ms >= minTimeMs || iterations >= (1ull << 40)) break;
+            double scale = ms > 0.0 ? std::min(10.0, std::max(2.0, 1.2 * minTimeMs / ms)) : 10.0;
+            iterations = static_cast<uint64_t>(iterations * scale);
+        }
+
+        std::vector<double> samples;
+        for (int i = 0; i < REPETITIONS; i++) {
+            samples.push_back(timeBatch(body, iterations) / iterations);
+        }
+        std::sort(samples.begin(), samples.end());
+
+        BenchResult result;
+        result.name = name;
+        result.iterations = iterations;
+        result.nsPerOp = samples[samples.size() / 2];
+        result.minNsPerOp = samples.front();
+        results.push_back(result);
+
+        Logger::getInstance().flush();  // Anything the benchmark logged goes first
+        std::cout << name << ": " << result.nsPerOp << " ns/op (min " << result.minNsPerOp << ", "
+                  << iterations << " iterations x " << REPETITIONS << ")" << std::endl;
+    }
+
+    bool writeJson(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file) {
+            std::cerr << "Failed to write " << path << std::endl;
+            return false;
+        }
+
+        file << "{\n  \"timestamp\": " << std::time(nullptr) << ",\n";
+#ifdef SUPAPLEX_PROFILER
+        file << "  \"profiler\": true,\n";
+#else
+        file << "  \"profiler\": false,\n";
+#endif
+        file << "  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchResult& result = results[i];
+            file << "    {\"name\": \"" << result.name << "\", \"iterations\": " << result.iterations
+                 << ", \"repetitions\": " << REPETITIONS << ", \"ns_per_op\": " << result.nsPerOp
+                 << ", \"min_ns_per_op\": " << result.minNsPerOp << "}"
+                 << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        file << "  ]\n}\n";
+        return true;
+    }
+
+private:
+    static double timeBatch(const std::function<void(uint64_t)>& body, uint64_t iterations) {
+        Clock::time_point start = Clock::now();
+        body(iterations);
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+
+    std::string filter;
+    double minTimeMs;
+    std::vector<BenchResult> results;
+};
+
+// Dense synthetic level: rows of zonks over a checkerboard of infotrons and
+// gaps, so most of the field falls and rolls for the first ~100 ticks
+void buildZonkField(Level& level) {
+    level.clearAllObjects();
+    for (int y = 0; y < Level::LEVEL_HEIGHT; y++) {
+        for (int x = 0; x < Level::LEVEL_WIDTH; x++) {
+            if (y < Level::LEVEL_HEIGHT / 2) {
+                level.createObject(ObjectType::ZONK, x, y);
+            } else if ((x + y) % 3 == 0) {
+                level.createObject(ObjectType::INFOTRON, x, y);
+            }
+        }
+    }
+    level.spawnMurphy(0, Level::LEVEL_HEIGHT - 1);
+}
+
+std::vector<std::pair<int, int>> randomCells(size_t count) {
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> xDist(0, Level::LEVEL_WIDTH - 1);
+    std::uniform_int_distribution<int> yDist(0, Level::LEVEL_HEIGHT - 1);
+
+    std::vector<std::pair<int, int>> cells(count);
+    for (auto& cell : cells) {
+        cell = {xDist(gen), yDist(gen)};
+    }
+    return cells;
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --levels <path>    Levels file (default assets/LEVELS.DAT)\n"
+              << "  --level <n>        Real level to benchmark (default 1)\n"
+              << "  --json <path>      Results file (default bench.json)\n"
+              << "  --filter <text>    Only run benchmarks whose name contains this\n"
+              << "  --min-time <ms>    Minimum time per repetition (default 50)\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string levelsPath = "assets/LEVELS.DAT";
+    std::string jsonPath = "bench.json";
+    std::string filter;
+    int levelNumber = 1;
+    double minTimeMs = 50.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--levels" && hasValue) {
+            levelsPath = argv[++i];
+        } else if (arg == "--level" && hasValue) {
+            levelNumber = std::atoi(argv[++i]);
+        } else if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else if (arg == "--filter" && hasValue) {
+            filter = argv[++i];
+        } else if (arg == "--min-time" && hasValue) {
+            minTimeMs = std::atof(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Software renderer on the dummy video driver, for renderRegion. Set up
+    // before any Level exists so levels pick up the sprite sheet.
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    SDL_Surface* renderSurface = nullptr;
+    SDL_Renderer* renderer = nullptr;
+    if (SDL_Init(SDL_INIT_VIDEO) == 0) {
+        renderSurface = SDL_CreateRGBSurfaceWithFormat(0, 320, 200, 32, SDL_PIXELFORMAT_RGBA8888);
+        renderer = renderSurface ? SDL_CreateSoftwareRenderer(renderSurface) : nullptr;
+    }
+    if (!renderer || !AssetManager::getInstance().initialize(renderer)) {
+        std::cerr << "No software renderer, skipping render benchmarks: " << SDL_GetError() << std::endl;
+    }
+
+    LevelLoader loader;
+    loader.setVerbose(false);
+    if (!loader.loadLevelsFile(levelsPath)) {
+        return 1;
+    }
+    if (levelNumber < 1 || levelNumber > loader.getLevelCount()) {
+        std::cerr << "Invalid level number: " << levelNumber << std::endl;
+        return 1;
+    }
+
+    BenchRunner runner(filter, minTimeMs);
+    const float tickDuration = 1.0f / 35.0f;
+    const std::string levelName = "level" + std::to_string(levelNumber);
+
+    Level level;
+    level.setLevelLoader(&loader);
+    level.loadFromFile(levelNumber);
+
+    // Lookups
+    const std::vector<std::pair<int, int>> cells = randomCells(4096);
+    runner.run("getObjectAt/" + levelName, [&](uint64_t iterations) {
+        uintptr_t sum = 0;
+        for (uint64_t i = 0; i < iterations; i++) {
+            const auto& cell = cells[i & 4095];
+            sum += reinterpret_cast<uintptr_t>(level.getObjectAt(cell.first, cell.second));
+        }
+        benchSink = sum;
+    });
+    runner.run("isWalkable/" + levelName, [&](uint64_t iterations) {
+        uintptr_t sum = 0;
+        for (uint64_t i = 0; i < iterations; i++) {
+            const auto& cell = cells[i & 4095];
+            sum += level.isWalkable(cell.first, cell.second);
+        }
+        benchSink = sum;
+    });
+
+    // Simulation ticks
+    runner.run("update/" + levelName, [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            level.update(tickDuration);
+        }
+    });
+
+    Level denseLevel;
+    denseLevel.loadTestLevel(1);
+    runner.run("update/test-level", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            denseLevel.update(tickDuration);
+        }
+    });
+
+    // The field settles after ~100 ticks, so each op is a rebuild plus 100 ticks
+    Level zonkLevel;
+    runner.run("update/zonk-field-100-ticks", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            buildZonkField(zonkLevel);
+            for (int tick = 0; tick < 100; tick++) {
+                zonkLevel.update(tickDuration);
+            }
+        }
+    });
+
+    // Loading
+    runner.run("loadLevelsFile", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            LevelLoader packLoader;
+            packLoader.setVerbose(false);
+            benchSink = packLoader.loadLevelsFile(levelsPath);
+        }
+    });
+
+    // Rotates through the pack, so after the first pass levels are already parsed
+    Level loadLevel;
+    runner.run("loadLevel/all", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            loader.loadLevel(&loadLevel, static_cast<int>(i % loader.getLevelCount()) + 1);
+        }
+    });
+
+    // Rendering: one full viewport per op, including the batch submission
+    if (renderer && AssetManager::getInstance().getSpriteAtlas().isLoaded()) {
+        SpriteBatch batch;
+        batch.setRenderer(renderer);
+
+        Level renderLevel;
+        renderLevel.setLevelLoader(&loader);
+        renderLevel.loadFromFile(levelNumber);
+        renderLevel.updateStaticLayer(batch);
+
+        runner.run("renderRegion/" + levelName, [&](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; i++) {
+                renderLevel.renderRegion(batch, -1, -1, 21, 12, 16.0f, 16.0f, 1.0f);
+                batch.flush();
+            }
+        });
+        runner.run("updateStaticLayer+renderRegion/" + levelName, [&](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; i++) {
+                renderLevel.update(tickDuration);
+                renderLevel.updateStaticLayer(batch);
+                renderLevel.renderRegion(batch, -1, -1, 21, 12, 16.0f, 16.0f, 1.0f);
+                batch.flush();
+            }
+        });
+    }
+
+    bool written = runner.writeJson(jsonPath);
+    if (written) {
+        std::cout << "Wrote " << jsonPath << std::endl;
+    }
+
+    AssetManager::getInstance().cleanup();
+    if (renderer) SDL_DestroyRenderer(renderer);
+    if (renderSurface) SDL_FreeSurface(renderSurface);
+    SDL_Quit();
+
+    return written ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+// Headless simulation runner: drives Level::update from scripted input or a replay at full
+// CPU speed, without creating an SDL window or renderer.
+#include "../main.hpp"
+#include "../game/Level.hpp"
+#include "../game/LevelLoader.hpp"
+#include "../game/Replay.hpp"
+#include "../game/SnapshotRing.hpp"
+#include "../systems/AllocationCounter.hpp"
+#include "../systems/InputProvider.hpp"
+#include "../systems/Log.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+// Length of the game's rewind history (Game::REWIND_SECONDS)
+static const int REWIND_SECONDS = 10;
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --levels <path>   Levels file (default assets/LEVELS.DAT)\n"
+              << "  --level <n>       Level number to simulate (default 1)\n"
+              << "  --ticks <n>       Ticks to simulate (default 3500)\n"
+              << "  --rate <hz>       Simulation tick rate (default 35)\n"
+              << "  --script <text>   Scripted input, e.g. \"R4 D2 .10 SL1\"\n"
+              << "  --record <path>   Save the scripted run as a .sprec replay\n"
+              << "  --replay <path>   Fast-forward through a .sprec replay instead\n"
+              << "  --seek <tick>     With --replay, seek to this tick, then back to it again\n"
+              << "  --check-allocations <warmup>\n"
+              << "                    Snapshot into a rewind ring every tick like the game does, and\n"
+              << "                    fail if anything allocates after the first <warmup> ticks\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string levelsPath = "assets/LEVELS.DAT";
+    std::string script;
+    std::string recordPath;
+    std::string replayPath;
+    int levelNumber = 1;
+    int tickCount = 3500;
+    int tickRate = 35;
+    int seekTick = -1;
+    int allocationWarmup = -1;  // Ticks before the zero-allocation check starts; -1 when off
+    
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        
+        if (arg == "--levels" && hasValue) {
+            levelsPath = argv[++i];
+        } else if (arg == "--level" && hasValue) {
+            levelNumber = std::atoi(argv[++i]);
+        } else if (arg == "--ticks" && hasValue) {
+            tickCount = std::atoi(argv[++i]);
+        } else if (arg == "--rate" && hasValue) {
+            tickRate = std::atoi(argv[++i]);
+        } else if (arg == "--script" && hasValue) {
+            script = argv[++i];
+        } else if (arg == "--record" && hasValue) {
+            recordPath = argv[++i];
+        } else if (arg == "--replay" && hasValue) {
+            replayPath = argv[++i];
+        } else if (arg == "--seek" && hasValue) {
+            seekTick = std::atoi(argv[++i]);
+        } else if (arg == "--check-allocations" && hasValue) {
+            allocationWarmup = std::atoi(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    bool checkAllocations = allocationWarmup >= 0;
+    if (tickCount <= 0 || tickRate <= 0 || (checkAllocations && (allocationWarmup >= tickCount || !replayPath.empty()))) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (checkAllocations && !AllocationCounter::isEnabled()) {
+        std::cerr << "--check-allocations needs a build with SUPAPLEX_COUNT_ALLOCATIONS" << std::endl;
+        return 1;
+    }
+    
+    LevelLoader levelLoader;
+    if (!levelLoader.loadLevelsFile(levelsPath)) {
+        return 1;
+    }
+    
+    Level level;
+    level.setLevelLoader(&levelLoader);
+    Replay replay;
+    std::chrono::high_resolution_clock::time_point start, end;
+    uint64_t steadyAllocations = 0;
+    
+    if (!replayPath.empty()) {
+        if (!replay.load(replayPath)) {
+            return 1;
+        }
+        levelNumber = replay.levelNumber;
+        tickRate = replay.tickRate;
+        tickCount = static_cast<int>(replay.inputs.size());
+        
+        ReplayPlayer player(&replay, &level);
+        if (!player.restart()) {
+            return 1;
+        }
+        
+        start = std::chrono::high_resolution_clock::now();
+        if (seekTick >= 0) {
+            // Forward to the tick, to the end, then back again (re-simulates)
+            player.seek(seekTick);
+            player.seek(player.getLength());
+            player.seek(seekTick);
+            Logger::getInstance().flush();
+            std::cout << "Seeked to tick " << player.getTick() << std::endl;
+        } else {
+            player.step(tickCount);
+        }
+        end = std::chrono::high_resolution_clock::now();
+    } else {
+        std::vector<InputState> inputs;
+        if (!ScriptedInputProvider::parse(script, inputs)) {
+            return 1;
+        }
+        ScriptedInputProvider scriptInput(std::move(inputs));
+        
+        replay.levelNumber = static_cast<uint16_t>(levelNumber);
+        replay.tickRate = static_cast<uint16_t>(tickRate);
+        ReplayRecorder recorder(&scriptInput, &replay);
+        
+        level.setInputProvider(&recorder);
+        if (!level.loadFromFile(levelNumber)) {
+            return 1;
+        }
+        
+        // The game's rewind history: ten seconds of snapshots, one per tick
+        SnapshotRing history(checkAllocations ? static_cast<size_t>(REWIND_SECONDS) * tickRate : 0);
+        std::vector<uint8_t> snapshot;
+        replay.inputs.reserve(tickCount);
+        uint64_t allocationBase = 0;
+        
+        const float tickDuration = 1.0f / tickRate;
+        start = std::chrono::high_resolution_clock::now();
+        for (int tick = 0; tick < tickCount; tick++) {
+            if (checkAllocations) {
+                if (tick == allocationWarmup) {
+                    allocationBase = AllocationCounter::getCount();
+                }
+                level.saveSnapshot(snapshot);
+                history.push(snapshot);
+            }
+            level.update(tickDuration);
+        }
+        end = std::chrono::high_resolution_clock::now();
+        steadyAllocations = AllocationCounter::getCount() - allocationBase;
+        
+        if (!recordPath.empty() && replay.save(recordPath)) {
+            Logger::getInstance().flush();
+            std::cout << "Saved replay of " << replay.inputs.size() << " ticks to " << recordPath << std::endl;
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    
+    // Diagnostics go through the async logger; let them out before the results
+    Logger::getInstance().flush();
+    std::cout << "Simulated " << tickCount << " ticks of level " << levelNumber
+              << " in " << seconds * 1000.0 << " ms ("
+              << (seconds > 0.0 ? tickCount / seconds : 0.0) << " ticks/s, "
+              << (seconds > 0.0 ? (tickCount / static_cast<double>(tickRate)) / seconds : 0.0)
+              << "x real time)" << std::endl;
+    
+    MurphyObject* murphy = level.getMurphy();
+    if (murphy) {
+        std::cout << "Murphy at (" << murphy->getX() << ", " << murphy->getY() << ")" << std::endl;
+    } else {
+        std::cout << "Murphy is gone" << std::endl;
+    }
+    std::cout << "Objects remaining: " << level.getObjectCount() << std::endl;
+    
+    if (checkAllocations) {
+        std::cout << "Heap allocations after " << allocationWarmup << " warm-up ticks: " << steadyAllocations
+                  << std::endl;
+        if (steadyAllocations != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
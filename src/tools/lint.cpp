@@ -0,0 +1,327 @@
+// Level pack lint: decodes every record of one or more LEVELS.DAT variants,
+// including the header fields the game ignores, and reports tile statistics
+// and problems per level as JSON. Levels of all packs are spread across
+// worker threads.
+#include "../main.hpp"
+#include "../game/LevelLoader.hpp"
+#include "../systems/Log.hpp"
+#include "../systems/MappedFile.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int TILE_COLUMNS = 60;
+constexpr int TILE_ROWS = 24;
+constexpr uint8_t LAST_KNOWN_TILE = 0x28;
+
+constexpr uint8_t TILE_MURPHY = 0x03;
+constexpr uint8_t TILE_INFOTRON = 0x04;
+constexpr uint8_t TILE_SPECIAL_PORT_FIRST = 0x0D;
+constexpr uint8_t TILE_SPECIAL_PORT_LAST = 0x10;
+constexpr uint8_t TILE_ELECTRON = 0x18;
+
+struct Issue {
+    const char* severity;  // "error" or "warning"
+    std::string message;
+};
+
+struct LevelReport {
+    int number = 0;
+    LevelData data;
+    std::array<int, 256> histogram{};
+    int murphyX = -1, murphyY = -1;  // Last Murphy tile, the one the loader uses
+    std::vector<Issue> issues;
+};
+
+struct PackReport {
+    std::string path;
+    MappedFile file;
+    int levelCount = 0;
+    size_t trailingBytes = 0;
+    std::vector<LevelReport> levels;
+};
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options] [pack...]\n"
+              << "  pack              Levels file(s) to check (default assets/LEVELS.DAT)\n"
+              << "  --json <path>     Write the report here instead of stdout\n"
+              << "  --threads <n>     Worker threads (default: one per core)\n";
+}
+
+std::string hexCode(uint8_t value) {
+    char text[8];
+    std::snprintf(text, sizeof(text), "0x%02X", value);
+    return text;
+}
+
+std::string cellText(int index) {
+    std::ostringstream out;
+    out << "(" << index % TILE_COLUMNS << ", " << index / TILE_COLUMNS << ")";
+    return out.str();
+}
+
+void addIssue(LevelReport& report, const char* severity, const std::string& message) {
+    report.issues.push_back({severity, message});
+}
+
+void lintLevel(const uint8_t* record, LevelReport& report) {
+    report.data = LevelLoader::parseLevelData(record);
+    const LevelData& data = report.data;
+
+    int murphyCount = 0;
+    std::array<int, 256> firstSeen;
+    firstSeen.fill(-1);
+    for (int index = 0; index < TILE_COLUMNS * TILE_ROWS; index++) {
+        uint8_t tile = data.tileData[index];
+        report.histogram[tile]++;
+        if (firstSeen[tile] < 0) firstSeen[tile] = index;
+
+        if (tile == TILE_MURPHY) {
+            murphyCount++;
+            report.murphyX = index % TILE_COLUMNS;
+            report.murphyY = index / TILE_COLUMNS;
+        }
+    }
+
+    // Tiles loadLevel drops without a word: unknown codes, and known ones
+    // that have no object yet
+    for (int tile = 0; tile < 256; tile++) {
+        int count = report.histogram[tile];
+        if (count == 0) continue;
+
+        ObjectType type;
+        std::string where = std::to_string(count) + "x, first at " + cellText(firstSeen[tile]);
+        if (tile > LAST_KNOWN_TILE) {
+            addIssue(report, "error", "unknown tile " + hexCode(tile) + " (" + where + ")");
+        } else if (tile != 0x00 && tile != TILE_MURPHY && !LevelLoader::tileToImplementedType(tile, type)) {
+            addIssue(report, "warning", "tile " + hexCode(tile) + " is not implemented and gets dropped (" + where + ")");
+        }
+    }
+
+    if (murphyCount == 0) {
+        addIssue(report, "error", "no Murphy tile, the loader falls back to (5, 10)");
+    } else if (murphyCount > 1) {
+        addIssue(report, "warning", std::to_string(murphyCount) + " Murphy tiles, the last one is used");
+    }
+
+    // A blown-up electron leaves up to 9 infotrons, so electrons can make up a shortfall
+    int infotrons = report.histogram[TILE_INFOTRON];
+    int needed = data.infrotronsNeeded;
+    if (needed > infotrons) {
+        std::string message = "needs " + std::to_string(needed) + " infotrons but only " +
+                              std::to_string(infotrons) + " are placed";
+        if (needed <= infotrons + 9 * report.histogram[TILE_ELECTRON]) {
+            addIssue(report, "warning", message + ", the rest must come from electrons");
+        } else {
+            addIssue(report, "error", message);
+        }
+    } else if (needed == 0 && infotrons == 0) {
+        addIssue(report, "warning", "needs every infotron but none are placed");
+    }
+
+    if (data.specialPortCount > LevelData::MAX_SPECIAL_PORTS) {
+        addIssue(report, "error", "special port count " + std::to_string(data.specialPortCount) + " exceeds " +
+                                  std::to_string(LevelData::MAX_SPECIAL_PORTS));
+    }
+    int portCount = std::min<int>(data.specialPortCount, LevelData::MAX_SPECIAL_PORTS);
+    for (int i = 0; i < portCount; i++) {
+        uint16_t position = data.specialPorts[i].position;
+        int index = position / 2;
+        if (position % 2 != 0 || index >= TILE_COLUMNS * TILE_ROWS) {
+            addIssue(report, "error", "special port " + std::to_string(i) + " has invalid position " +
+                                      std::to_string(position));
+            continue;
+        }
+        uint8_t tile = data.tileData[index];
+        if (tile < TILE_SPECIAL_PORT_FIRST || tile > TILE_SPECIAL_PORT_LAST) {
+            addIssue(report, "warning", "special port " + std::to_string(i) + " at " + cellText(index) +
+                                        " is on tile " + hexCode(tile) + ", not a special port");
+        }
+    }
+}
+
+std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (unsigned char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20 || c >= 0x7F) {
+            // Titles are raw bytes; keep the output plain ASCII
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    return out + "\"";
+}
+
+void writeLevel(std::ostream& out, const LevelReport& report) {
+    const LevelData& data = report.data;
+    out << "        {\"level\": " << report.number << ", \"title\": " << jsonString(data.title)
+        << ", \"gravity\": " << (data.gravity ? "true" : "false")
+        << ", \"freeze_zonks\": " << (data.freezeZonks ? "true" : "false")
+        << ", \"infotrons_needed\": " << static_cast<int>(data.infrotronsNeeded)
+        << ", \"infotrons_placed\": " << report.histogram[TILE_INFOTRON];
+
+    out << ", \"murphy\": ";
+    if (report.murphyX >= 0) {
+        out << "[" << report.murphyX << ", " << report.murphyY << "]";
+    } else {
+        out << "null";
+    }
+
+    out << ",\n         \"tiles\": {";
+    bool first = true;
+    for (int tile = 0; tile < 256; tile++) {
+        if (report.histogram[tile] == 0) continue;
+        out << (first ? "" : ", ") << "\"" << hexCode(tile) << "\": " << report.histogram[tile];
+        first = false;
+    }
+
+    out << "},\n         \"special_ports\": [";
+    int portCount = std::min<int>(data.specialPortCount, LevelData::MAX_SPECIAL_PORTS);
+    for (int i = 0; i < portCount; i++) {
+        const SpecialPort& port = data.specialPorts[i];
+        int index = port.position / 2;
+        out << (i ? ", " : "") << "{\"x\": " << index % TILE_COLUMNS << ", \"y\": " << index / TILE_COLUMNS
+            << ", \"gravity\": " << (port.gravity ? "true" : "false")
+            << ", \"freeze_zonks\": " << (port.freezeZonks ? "true" : "false")
+            << ", \"freeze_enemies\": " << (port.freezeEnemies ? "true" : "false") << "}";
+    }
+
+    out << "],\n         \"issues\": [";
+    for (size_t i = 0; i < report.issues.size(); i++) {
+        out << (i ? ", " : "") << "{\"severity\": \"" << report.issues[i].severity
+            << "\", \"message\": " << jsonString(report.issues[i].message) << "}";
+    }
+    out << "]}";
+}
+
+void writeReport(std::ostream& out, const std::vector<std::unique_ptr<PackReport>>& packs) {
+    out << "{\n  \"packs\": [\n";
+    for (size_t p = 0; p < packs.size(); p++) {
+        const PackReport& pack = *packs[p];
+        out << "    {\"path\": " << jsonString(pack.path) << ", \"opened\": " << (pack.file.isOpen() ? "true" : "false")
+            << ", \"level_count\": " << pack.levelCount << ", \"trailing_bytes\": " << pack.trailingBytes
+            << ",\n      \"levels\": [\n";
+        for (size_t i = 0; i < pack.levels.size(); i++) {
+            writeLevel(out, pack.levels[i]);
+            out << (i + 1 < pack.levels.size() ? ",\n" : "\n");
+        }
+        out << "      ]}" << (p + 1 < packs.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> packPaths;
+    std::string jsonPath;
+    int threadCount = static_cast<int>(std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else if (arg == "--threads" && hasValue) {
+            threadCount = std::atoi(argv[++i]);
+        } else if (!arg.empty() && arg[0] != '-') {
+            packPaths.push_back(arg);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (packPaths.empty()) {
+        packPaths.push_back("assets/LEVELS.DAT");
+    }
+
+    // Map every pack up front; the records are then linted in place
+    std::vector<std::unique_ptr<PackReport>> packs;
+    std::vector<std::pair<PackReport*, int>> jobs;
+    for (const std::string& path : packPaths) {
+        std::unique_ptr<PackReport> pack(new PackReport());
+        pack->path = path;
+        if (pack->file.open(path)) {
+            pack->levelCount = static_cast<int>(pack->file.size() / LevelLoader::LEVEL_RECORD_SIZE);
+            pack->trailingBytes = pack->file.size() % LevelLoader::LEVEL_RECORD_SIZE;
+            pack->levels.resize(pack->levelCount);
+            for (int i = 0; i < pack->levelCount; i++) {
+                jobs.emplace_back(pack.get(), i);
+            }
+        } else {
+            std::cerr << "Failed to open " << path << std::endl;
+        }
+        packs.push_back(std::move(pack));
+    }
+
+    // Workers pull levels of all packs off one counter, so a big pack
+    // doesn't leave the other threads idle
+    const int jobCount = static_cast<int>(jobs.size());
+    threadCount = std::max(1, std::min(threadCount, jobCount));
+    std::atomic<int> nextJob(0);
+    auto worker = [&]() {
+        int job;
+        while ((job = nextJob.fetch_add(1)) < jobCount) {
+            PackReport* pack = jobs[job].first;
+            int index = jobs[job].second;
+            LevelReport& report = pack->levels[index];
+            report.number = index + 1;
+            lintLevel(pack->file.data() + index * LevelLoader::LEVEL_RECORD_SIZE, report);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; i++) {
+        threads.emplace_back(worker);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    Logger::getInstance().flush();  // Loader diagnostics before the report
+    if (jsonPath.empty()) {
+        writeReport(std::cout, packs);
+    } else {
+        std::ofstream file(jsonPath);
+        if (!file) {
+            std::cerr << "Failed to write " << jsonPath << std::endl;
+            return 1;
+        }
+        writeReport(file, packs);
+    }
+
+    // Summary goes to stderr so stdout stays valid JSON
+    int errors = 0, warnings = 0;
+    for (const auto& pack : packs) {
+        if (!pack->file.isOpen()) errors++;
+        for (const LevelReport& report : pack->levels) {
+            for (const Issue& issue : report.issues) {
+                (std::string(issue.severity) == "error" ? errors : warnings)++;
+            }
+        }
+    }
+    std::cerr << "Linted " << jobCount << " levels in " << packs.size() << " packs on " << threadCount
+              << " threads in " << ms << " ms: " << errors << " errors, " << warnings << " warnings" << std::endl;
+
+    return errors > 0 ? 1 : 0;
+}
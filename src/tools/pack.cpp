@@ -0,0 +1,125 @@
+// Offline asset packer: decodes the PNGs in the asset manifest to raw RGBA32
+// and bakes them, the sprite table and the level pack into one bundle that
+// the game maps at startup instead of going through SDL_image.
+#include "../main.hpp"
+#include "../systems/AssetBundle.hpp"
+#include "../systems/AssetManager.hpp"
+#include "../systems/MappedFile.hpp"
+#include "../systems/SpriteAtlas.hpp"
+#include <SDL2/SDL_image.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --levels <path>   Levels file (default assets/LEVELS.DAT)\n"
+              << "  --out <path>      Bundle to write (default " << AssetManager::BUNDLE_PATH << ")\n"
+              << "  --lz4             LZ4-compress images (smaller file, slower start)\n";
+}
+
+// Decodes a PNG into tightly packed RGBA32 rows
+bool loadRgba(const char* path, std::vector<uint8_t>& pixels, int& width, int& height) {
+    SDL_Surface* loaded = IMG_Load(path);
+    if (!loaded) {
+        return false;
+    }
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loaded);
+    if (!converted) {
+        return false;
+    }
+    
+    width = converted->w;
+    height = converted->h;
+    pixels.resize(size_t(width) * height * 4);
+    
+    SDL_LockSurface(converted);
+    for (int y = 0; y < height; y++) {
+        std::memcpy(&pixels[size_t(y) * width * 4], static_cast<const uint8_t*>(converted->pixels) + y * converted->pitch,
+                    size_t(width) * 4);
+    }
+    SDL_UnlockSurface(converted);
+    SDL_FreeSurface(converted);
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string levelsPath = AssetManager::LEVEL_PACK_PATH;
+    std::string outPath = AssetManager::BUNDLE_PATH;
+    bool compress = false;
+    
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        
+        if (arg == "--levels" && hasValue) {
+            levelsPath = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            outPath = argv[++i];
+        } else if (arg == "--lz4") {
+            compress = true;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    int imgFlags = IMG_INIT_PNG;
+    if (!(IMG_Init(imgFlags) & imgFlags)) {
+        std::cerr << "SDL_image could not initialize! SDL_image Error: " << IMG_GetError() << std::endl;
+        return 1;
+    }
+    
+    AssetBundleWriter writer;
+    bool success = true;
+    for (size_t i = 0; i < AssetManager::MANIFEST_SIZE; i++) {
+        const AssetManifestEntry& asset = AssetManager::MANIFEST[i];
+        
+        std::vector<uint8_t> pixels;
+        int width, height;
+        if (!loadRgba(asset.path, pixels, width, height)) {
+            std::cerr << "Unable to load image " << asset.path << "! SDL_image Error: " << IMG_GetError() << std::endl;
+            if (asset.required) {
+                success = false;
+            }
+            continue;
+        }
+        
+        writer.addImage(asset.name, width, height, pixels.data(), compress, asset.path);
+        if (std::strcmp(asset.name, "sprites") == 0) {
+            writer.addSpriteTable(AssetManager::SPRITE_TABLE_ENTRY, SpriteAtlas::gridRects(height), asset.path);
+        }
+    }
+    IMG_Quit();
+    
+    // Stored raw so the loader can parse levels straight from the mapping
+    MappedFile levelsFile;
+    if (levelsFile.open(levelsPath)) {
+        writer.addBlob(AssetManager::LEVEL_PACK_ENTRY, levelsFile.data(), levelsFile.size(), false, levelsPath);
+    } else {
+        std::cerr << "Failed to open levels file: " << levelsPath << std::endl;
+        success = false;
+    }
+    
+    if (!success || !writer.write(outPath)) {
+        return 1;
+    }
+    
+    size_t total = 0;
+    for (const AssetBundle::Entry& entry : writer.getEntries()) {
+        std::cout << "  " << entry.name << ": " << entry.storedSize << " bytes";
+        if (entry.compression == AssetBundle::Compression::LZ4) {
+            std::cout << " (" << entry.rawSize << " uncompressed)";
+        }
+        std::cout << std::endl;
+        total += entry.storedSize;
+    }
+    std::cout << "Wrote " << outPath << ": " << writer.getEntries().size() << " entries, " << total
+              << " bytes of data" << std::endl;
+    return 0;
+}
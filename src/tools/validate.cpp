@@ -0,0 +1,225 @@
+// Batch level validator: simulates every level of a pack headless, spread
+// across worker threads, and checks simulation invariants on every tick.
+#include "../main.hpp"
+#include "../game/Level.hpp"
+#include "../game/LevelLoader.hpp"
+#include "../systems/InputProvider.hpp"
+#include "../systems/Log.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct LevelResult {
+    bool loaded = false;
+    int failedTick = -1;  // -1 when every invariant held
+    std::string failure;
+    size_t objectsRemaining = 0;
+};
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --levels <path>   Levels file (default assets/LEVELS.DAT)\n"
+              << "  --ticks <n>       Ticks to simulate per level (default 3500)\n"
+              << "  --rate <hz>       Simulation tick rate (default 35)\n"
+              << "  --script <text>   Scripted input for every level, e.g. \"R4 D2 .10 SL1\" (default idle)\n"
+              << "  --threads <n>     Worker threads (default: one per core)\n";
+}
+
+const char* typeName(ObjectType type) {
+    switch (type) {
+        case ObjectType::BASE: return "base";
+        case ObjectType::INFOTRON: return "infotron";
+        case ObjectType::ZONK: return "zonk";
+        case ObjectType::CHIP_1: return "chip";
+        case ObjectType::PLAYER: return "Murphy";
+        default: return "object";
+    }
+}
+
+// Per-worker scratch grid; cells are stamped with the tick that last claimed
+// them so it never needs clearing
+class InvariantChecker {
+public:
+    InvariantChecker() {
+        stamps.fill(-1);
+        owners.fill(nullptr);
+    }
+
+    bool check(const Level& level, int tick, std::string& failure) {
+        const MurphyObject* murphy = level.getMurphy();
+        if (murphy && (murphy->getX() < 0 || murphy->getX() >= Level::LEVEL_WIDTH ||
+                       murphy->getY() < 0 || murphy->getY() >= Level::LEVEL_HEIGHT)) {
+            failure = "Murphy out of bounds at " + position(murphy);
+            return false;
+        }
+
+        for (const GameObject* obj : level.getObjects()) {
+            if (!obj->isActive() || obj == murphy) continue;
+
+            int x = obj->getX();
+            int y = obj->getY();
+            if (x < 0 || x >= Level::LEVEL_WIDTH || y < 0 || y >= Level::LEVEL_HEIGHT) {
+                failure = std::string(typeName(obj->getType())) + " out of bounds at " + position(obj);
+                return false;
+            }
+
+            int index = y * Level::LEVEL_WIDTH + x;
+            if (stamps[index] == tick) {
+                failure = std::string(typeName(owners[index]->getType())) + " and " + typeName(obj->getType()) +
+                          " share cell " + position(obj);
+                return false;
+            }
+            stamps[index] = tick;
+            owners[index] = obj;
+        }
+
+        // Murphy may walk onto a base or infotron, but never into a zonk
+        if (murphy && murphy->isActive()) {
+            int index = murphy->getY() * Level::LEVEL_WIDTH + murphy->getX();
+            if (stamps[index] == tick && owners[index]->getType() == ObjectType::ZONK) {
+                failure = "zonk overlaps Murphy at " + position(murphy);
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    static std::string position(const GameObject* obj) {
+        std::ostringstream out;
+        out << "(" << obj->getX() << ", " << obj->getY() << ")";
+        return out.str();
+    }
+
+    std::array<int, Level::LEVEL_WIDTH * Level::LEVEL_HEIGHT> stamps;
+    std::array<const GameObject*, Level::LEVEL_WIDTH * Level::LEVEL_HEIGHT> owners;
+};
+
+LevelResult validateLevel(const LevelLoader& loader, int levelNumber, const std::vector<InputState>& script,
+                          int tickCount, float tickDuration, InvariantChecker& checker, int& stampBase) {
+    LevelResult result;
+
+    ScriptedInputProvider input(script);
+    Level level;
+    level.setLevelLoader(&loader);
+    level.setInputProvider(&input);
+    if (!level.loadFromFile(levelNumber)) {
+        return result;
+    }
+    result.loaded = true;
+
+    // Tick 0 is the freshly loaded level
+    for (int tick = 0; tick <= tickCount; tick++) {
+        if (tick > 0) {
+            level.update(tickDuration);
+        }
+        if (!checker.check(level, stampBase + tick, result.failure)) {
+            result.failedTick = tick;
+            break;
+        }
+    }
+    stampBase += tickCount + 1;
+
+    result.objectsRemaining = level.getObjectCount();
+    return result;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string levelsPath = "assets/LEVELS.DAT";
+    std::string scriptText;
+    int tickCount = 3500;
+    int tickRate = 35;
+    int threadCount = static_cast<int>(std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--levels" && hasValue) {
+            levelsPath = argv[++i];
+        } else if (arg == "--ticks" && hasValue) {
+            tickCount = std::atoi(argv[++i]);
+        } else if (arg == "--rate" && hasValue) {
+            tickRate = std::atoi(argv[++i]);
+        } else if (arg == "--script" && hasValue) {
+            scriptText = argv[++i];
+        } else if (arg == "--threads" && hasValue) {
+            threadCount = std::atoi(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (tickCount <= 0 || tickRate <= 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<InputState> script;
+    if (!ScriptedInputProvider::parse(scriptText, script)) {
+        return 1;
+    }
+
+    LevelLoader loader;
+    loader.setVerbose(false);
+    if (!loader.loadLevelsFile(levelsPath)) {
+        return 1;
+    }
+
+    const int levelCount = loader.getLevelCount();
+    threadCount = std::max(1, std::min(threadCount, levelCount));
+    std::vector<LevelResult> results(levelCount);
+
+    // Workers pull the next level off a shared counter, so slow levels
+    // don't hold up a fixed slice of the pack
+    std::atomic<int> nextLevel(0);
+    const float tickDuration = 1.0f / tickRate;
+    auto worker = [&]() {
+        InvariantChecker checker;
+        int stampBase = 0;
+        int index;
+        while ((index = nextLevel.fetch_add(1)) < levelCount) {
+            results[index] = validateLevel(loader, index + 1, script, tickCount, tickDuration, checker, stampBase);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; i++) {
+        threads.emplace_back(worker);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Logger::getInstance().flush();  // Level diagnostics before the results
+
+    int failures = 0;
+    for (int i = 0; i < levelCount; i++) {
+        const LevelResult& result = results[i];
+        if (!result.loaded) {
+            std::cout << "Level " << i + 1 << ": failed to load" << std::endl;
+            failures++;
+        } else if (result.failedTick >= 0) {
+            std::cout << "Level " << i + 1 << " \"" << loader.getLevelTitle(i + 1) << "\": tick "
+                      << result.failedTick << ": " << result.failure << std::endl;
+            failures++;
+        }
+    }
+
+    std::cout << "Validated " << levelCount << " levels x " << tickCount << " ticks on "
+              << threadCount << " threads in " << seconds * 1000.0 << " ms, "
+              << failures << " failed" << std::endl;
+
+    return failures > 0 ? 1 : 0;
+}